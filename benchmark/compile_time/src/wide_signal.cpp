@@ -0,0 +1,55 @@
+//Compile-time benchmark
+//Instantiates a signal with many signatures, connects a slot to it and emits
+//every signature. Measure the time it takes to compile this file.
+
+#include <fgsig.hpp>
+#include <cstddef>
+#include <utility>
+
+#ifndef SIGNATURE_COUNT
+#define SIGNATURE_COUNT 128
+#endif
+
+namespace
+{
+
+template<std::size_t Index>
+struct event
+{
+    int value = 0;
+};
+
+template<typename IndexSequence>
+struct wide_signal_helper;
+
+template<std::size_t... Indexes>
+struct wide_signal_helper<std::index_sequence<Indexes...>>
+{
+    using type = fgsig::signal<void(const event<Indexes>&)...>;
+
+    template<typename Signal>
+    static void emit_all(Signal& sig)
+    {
+        (sig.emit(event<Indexes>{static_cast<int>(Indexes)}), ...);
+    }
+};
+
+using helper = wide_signal_helper<std::make_index_sequence<SIGNATURE_COUNT>>;
+
+using wide_signal = helper::type;
+
+} //namespace
+
+int main()
+{
+    auto sum = 0;
+
+    wide_signal sig;
+    auto slot = [&sum](const auto& e){sum += e.value;};
+    auto connection = fgsig::connect(sig, slot);
+    auto owning_connection = fgsig::connect(sig, [&sum](const auto& e){sum -= e.value;});
+
+    helper::emit_all(sig);
+
+    return sum;
+}
@@ -0,0 +1,135 @@
+//Runtime benchmark
+//Connects slots of a few types in random order, then measures the time an
+//emission takes with a plain signature and with a grouped one, for several
+//numbers of slots.
+//Grouping the slots by type makes emit() call the same function several times
+//in a row, which the branch predictor handles better than a random sequence of
+//functions. However, emit() then visits the closures in a different order than
+//the order they've been allocated in, which costs more than it saves once they
+//don't fit in the L1 cache anymore.
+
+#include <fgsig.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr auto slot_type_count = std::size_t{8};
+constexpr int slots_per_type_values[] = {4, 16, 32, 64, 128};
+constexpr auto slot_call_count = 20'000'000;
+
+template<std::size_t Index>
+struct accumulator
+{
+    void operator()(const int value)
+    {
+        sum += static_cast<unsigned int>(value) * (Index + 1);
+    }
+
+    unsigned int sum = 0;
+};
+
+template<typename Signal, std::size_t... Indexes>
+struct fixture
+{
+    public:
+        fixture(const std::vector<std::size_t>& slot_types)
+        {
+            using connect_fn = void(*)(fixture&);
+            constexpr connect_fn connect_fns[] = {&fixture::connect_slot<Indexes>...};
+
+            for(const auto type: slot_types)
+                connect_fns[type](*this);
+        }
+
+        //Average duration of an emission, in nanoseconds
+        double measure(const int emission_count)
+        {
+            //warm-up
+            sig.emit(0);
+
+            const auto start = std::chrono::steady_clock::now();
+            for(auto i = 0; i < emission_count; ++i)
+                sig.emit(i);
+            const auto end = std::chrono::steady_clock::now();
+
+            return std::chrono::duration<double, std::nano>(end - start).count() / emission_count;
+        }
+
+        //Keeps the compiler from optimizing the slots away.
+        unsigned int checksum() const
+        {
+            auto sum = 0u;
+            ((sum += sum_of(std::get<Indexes>(slots))), ...);
+            return sum;
+        }
+
+    private:
+        template<std::size_t Index>
+        static void connect_slot(fixture& self)
+        {
+            auto& slot = std::get<Index>(self.slots).emplace_back();
+            self.connections.push_back(std::make_shared<fgsig::connection<Signal, accumulator<Index>>>(self.sig, slot));
+        }
+
+        template<typename Slots>
+        static unsigned int sum_of(const Slots& slots)
+        {
+            auto sum = 0u;
+            for(const auto& slot: slots)
+                sum += slot.sum;
+            return sum;
+        }
+
+    private:
+        Signal sig;
+        std::tuple<std::deque<accumulator<Indexes>>...> slots;
+        std::vector<std::shared_ptr<void>> connections;
+};
+
+template<typename Signal, std::size_t... Indexes>
+double run(std::index_sequence<Indexes...>, const std::vector<std::size_t>& slot_types, unsigned int& checksum)
+{
+    auto f = fixture<Signal, Indexes...>{slot_types};
+    const auto duration = f.measure(slot_call_count / static_cast<int>(slot_types.size()));
+    checksum += f.checksum();
+    return duration;
+}
+
+} //namespace
+
+int main()
+{
+    const auto indexes = std::make_index_sequence<slot_type_count>{};
+    auto checksum = 0u;
+
+    std::cout << "slots  plain (ns/emission)  grouped (ns/emission)\n";
+
+    for(const auto slots_per_type: slots_per_type_values)
+    {
+        //The type of each slot, in connection order
+        auto slot_types = std::vector<std::size_t>{};
+        for(auto i = 0; i < slots_per_type; ++i)
+            for(auto type = std::size_t{0}; type < slot_type_count; ++type)
+                slot_types.push_back(type);
+        std::shuffle(slot_types.begin(), slot_types.end(), std::mt19937{42});
+
+        const auto plain_duration = run<fgsig::signal<void(int)>>(indexes, slot_types, checksum);
+        const auto grouped_duration = run<fgsig::signal<fgsig::grouped<void(int)>>>(indexes, slot_types, checksum);
+
+        std::cout << slot_types.size() << "  " << plain_duration << "  " << grouped_duration << '\n';
+    }
+
+    std::cout << "(checksum: " << checksum << ")\n";
+
+    return 0;
+}
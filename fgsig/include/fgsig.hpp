@@ -10,6 +10,29 @@ You might want to include only the headers you need to improve compile time.
 */
 
 #include "fgsig/any_connection.hpp"
+#include "fgsig/async_connection.hpp"
+#include "fgsig/coalescing_signal.hpp"
+#include "fgsig/combined.hpp"
+#include "fgsig/combiners.hpp"
 #include "fgsig/connection.hpp"
+#include "fgsig/connection_set.hpp"
+#include "fgsig/dispatcher.hpp"
+#include "fgsig/emission_recorder.hpp"
+#include "fgsig/event_bus.hpp"
+#include "fgsig/grouped.hpp"
+#include "fgsig/inline_slots.hpp"
+#ifdef __linux__
+#include "fgsig/ipc_signal.hpp"
+#endif
+#include "fgsig/method_slot.hpp"
+#include "fgsig/non_reentrant.hpp"
 #include "fgsig/owning_connection.hpp"
+#include "fgsig/shared_block.hpp"
 #include "fgsig/signal.hpp"
+#include "fgsig/signal_array.hpp"
+#include "fgsig/signal_view.hpp"
+#include "fgsig/signature_list.hpp"
+#include "fgsig/strand.hpp"
+#include "fgsig/thread_pool.hpp"
+#include "fgsig/trackable.hpp"
+#include "fgsig/tracing.hpp"
@@ -25,6 +25,9 @@ struct any_connection
         {
             virtual ~abstract_connection_holder(){}
             virtual void close() = 0;
+            virtual void block() = 0;
+            virtual void unblock() = 0;
+            virtual bool blocked() const = 0;
         };
 
         template<typename Connection>
@@ -41,6 +44,21 @@ struct any_connection
                     connection_.close();
                 }
 
+                void block()
+                {
+                    connection_.block();
+                }
+
+                void unblock()
+                {
+                    connection_.unblock();
+                }
+
+                bool blocked() const
+                {
+                    return connection_.blocked();
+                }
+
             private:
                 Connection connection_;
         };
@@ -71,6 +89,21 @@ struct any_connection
             holder_->close();
         }
 
+        void block()
+        {
+            holder_->block();
+        }
+
+        void unblock()
+        {
+            holder_->unblock();
+        }
+
+        bool blocked() const
+        {
+            return holder_->blocked();
+        }
+
     private:
         std::unique_ptr<abstract_connection_holder> holder_;
 };
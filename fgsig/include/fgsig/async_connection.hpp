@@ -0,0 +1,184 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_ASYNC_CONNECTION_HPP
+#define FGSIG_ASYNC_CONNECTION_HPP
+
+#include "signal.hpp"
+#include "detail/serial_queue.hpp"
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    /*
+    async_slot is the slot that async_connection connects to the signal.
+    Instead of calling the user slot, it copies or moves the arguments into a
+    call that it posts to its queue.
+    Slot is either an object type (the slot is owned) or an lvalue reference
+    type.
+    Posted calls hold a shared pointer to the async_slot, so that a connection
+    closed or destroyed by the call it's running (or by any other task of the
+    executor's threads) doesn't free the slot under its feet. async_slot
+    objects must then be created with std::make_shared.
+    */
+    template<typename Slot, typename Executor>
+    struct async_slot: std::enable_shared_from_this<async_slot<Slot, Executor>>
+    {
+        public:
+            template<typename Slot2>
+            async_slot(Slot2&& slot, Executor& executor):
+                slot_(std::forward<Slot2>(slot)),
+                pqueue_(std::make_shared<serial_queue<Executor>>(executor))
+            {
+            }
+
+            async_slot(const async_slot&) = delete;
+
+            async_slot(async_slot&&) = delete;
+
+            async_slot& operator=(const async_slot&) = delete;
+
+            async_slot& operator=(async_slot&&) = delete;
+
+            //Constrained so that the connection is only made to the
+            //signatures the slot can be called with.
+            template
+            <
+                typename... Args,
+                typename = std::enable_if_t<std::is_invocable_v<std::remove_reference_t<Slot>&, Args...>>
+            >
+            void operator()(Args&&... args)
+            {
+                pqueue_->post
+                (
+                    [pself = this->shared_from_this(), arg_copies = std::make_tuple(std::decay_t<Args>(std::forward<Args>(args))...)]() mutable
+                    {
+                        std::apply
+                        (
+                            [&pself](auto&... values)
+                            {
+                                pself->slot_(std::forward<Args>(values)...);
+                            },
+                            arg_copies
+                        );
+                    }
+                );
+            }
+
+            void close()
+            {
+                pqueue_->close();
+            }
+
+        private:
+            Slot slot_;
+            std::shared_ptr<serial_queue<Executor>> pqueue_;
+    };
+}
+
+/*
+async_connection establishes a connection between the given signal and slot,
+where the slot is called on the given executor instead of being called by
+emit().
+Executor is any type that has a post() member function taking a
+std::function<void()>, such as thread_pool or strand. It must outlive the
+connection.
+The arguments are copied or moved into the posted call, so their decayed types
+must be copy-constructible. Only void signatures are supported.
+The calls of a connection are made one after the other, in the order of the
+emissions, even on an executor that runs tasks concurrently.
+The slot is owned if it's given as an rvalue.
+Like any connection, async_connection must be closed or destroyed on the thread
+that uses the signal. Once close() has returned, the slot isn't called anymore.
+If close() is called by the running call itself, it can't wait: the call goes
+on, and the slot lives until the call returns, even if the connection is
+destroyed in the meantime.
+An exception thrown by the slot propagates to the executor, out of the task it
+has run. The next calls are still made, by another task posted to the
+executor. Note that thread_pool doesn't catch exceptions, so that such an
+exception terminates the program.
+*/
+template<typename Signal, typename Slot, typename Executor>
+struct async_connection
+{
+    private:
+        using async_slot = detail::async_slot<Slot, Executor>;
+
+    public:
+        template<typename Slot2>
+        async_connection(Signal& sig, Slot2&& slot, Executor& executor):
+            pslot_(std::make_shared<async_slot>(std::forward<Slot2>(slot), executor)),
+            connection_(sig, *pslot_)
+        {
+        }
+
+        async_connection(const async_connection&) = delete;
+
+        async_connection(async_connection&&) = default;
+
+        async_connection& operator=(const async_connection&) = delete;
+
+        async_connection& operator=(async_connection&&) = delete;
+
+        ~async_connection()
+        {
+            close();
+        }
+
+        /*
+        Close the connection, discard the pending calls and wait for the
+        running one (if any) to return.
+        */
+        void close()
+        {
+            if(pslot_)
+            {
+                connection_.close();
+                pslot_->close();
+            }
+        }
+
+    private:
+        std::shared_ptr<async_slot> pslot_;
+        connection<Signal, async_slot> connection_;
+};
+
+/*
+Connect the given slot to the given signal so that the slot is called
+asynchronously on the given executor.
+*/
+template<typename Signal, typename Slot, typename Executor>
+auto connect(Signal& sig, Slot&& slot, Executor& executor)
+{
+    using decaid_signal_t = std::decay_t<Signal>;
+
+    static_assert(!std::is_const_v<Signal>);
+
+    //Own rvalue slots, reference lvalue ones.
+    using stored_slot_t = std::conditional_t
+    <
+        std::is_rvalue_reference_v<decltype(slot)>,
+        std::decay_t<Slot>,
+        Slot
+    >;
+
+    return async_connection<decaid_signal_t, stored_slot_t, Executor>
+    {
+        sig,
+        std::forward<Slot>(slot),
+        executor
+    };
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,162 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_COALESCING_SIGNAL_HPP
+#define FGSIG_COALESCING_SIGNAL_HPP
+
+#include "signal.hpp"
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    /*
+    coalescing_signal_leaf holds the pending arguments of a single signature.
+    */
+
+    template<typename Signature>
+    struct coalescing_signal_leaf
+    {
+        static_assert
+        (
+            std::is_function_v<Signature>,
+            "The signatures of a coalescing_signal can't be wrapped (with fgsig::combined, fgsig::grouped, fgsig::non_reentrant, fgsig::inline_slots...)."
+        );
+    };
+
+    template<typename R, typename... Args>
+    struct coalescing_signal_leaf<R(Args...)>
+    {
+        static_assert(std::is_same_v<R, void>, "The signatures of a coalescing_signal must return void.");
+
+        public:
+            //Record the given arguments, overwriting the previously recorded
+            //ones if any.
+            void emit(Args... args)
+            {
+                pending_args_.emplace(std::forward<Args>(args)...);
+            }
+
+            //Deliver the recorded arguments (if any) to the given signal.
+            template<typename Signal>
+            void flush(Signal& sig)
+            {
+                if(!pending_args_)
+                    return;
+
+                //Move the arguments out before emitting, so that slots can
+                //emit again during the flush.
+                auto args = std::move(*pending_args_);
+                pending_args_.reset();
+
+                std::apply
+                (
+                    [&sig](auto&... values)
+                    {
+                        sig.emit(std::forward<Args>(values)...);
+                    },
+                    args
+                );
+            }
+
+        private:
+            std::optional<std::tuple<std::decay_t<Args>...>> pending_args_;
+    };
+
+    /*
+    Base type for coalescing_signal
+    Like signal_base, we use inheritance to let the compiler do the overload
+    resolution for the emit() member function.
+    */
+    template<typename... Signatures>
+    struct coalescing_signal_base: public coalescing_signal_leaf<Signatures>...
+    {
+        public:
+            using coalescing_signal_leaf<Signatures>::emit...;
+    };
+}
+
+/*
+coalescing_signal is a signal whose emit() function doesn't call the slots.
+Instead, emit() records the given arguments, overwriting the ones previously
+recorded for the same signature. flush() then delivers the latest arguments of
+each signature once, in the order of the signatures.
+Use it for signals that are emitted in bursts whose slots only need the latest
+value.
+Slots are connected with fgsig::connect(), like with a signal. Apart from
+that, only the functions that don't emit are available, so that every
+emission goes through flush().
+Signatures must return void and can't be wrapped.
+Arguments are stored by value, so the decayed argument types must be
+move-constructible.
+*/
+template<typename... Signatures>
+struct coalescing_signal:
+    private detail::coalescing_signal_base<Signatures...>,
+    private signal<Signatures...>
+{
+    private:
+        template<typename Signal, typename Slot, typename SignatureList>
+        friend struct connection;
+
+        template<typename Signal, typename Slot, typename SignatureList>
+        friend struct connection_set;
+
+        template<typename Signal, typename Slot, typename SignatureList>
+        friend struct detail::tracked_subscription;
+
+        using signal_t = signal<Signatures...>;
+
+    public:
+        template<typename Slot>
+        using connection = connection<coalescing_signal, Slot>;
+
+        template<typename Slot>
+        using owning_connection = owning_connection<coalescing_signal, Slot>;
+
+        template<typename Slot>
+        using connection_set = connection_set<coalescing_signal, Slot>;
+
+    public:
+        using detail::coalescing_signal_base<Signatures...>::emit;
+
+        void flush()
+        {
+            auto& sig = static_cast<signal_t&>(*this);
+            (
+                static_cast<detail::coalescing_signal_leaf<Signatures>&>(*this).flush(sig),
+                ...
+            );
+        }
+
+        using signal_t::slot_count;
+
+        using signal_t::empty;
+
+        using signal_t::reserve;
+
+        using signal_t::shrink_to_fit;
+
+        /*
+        Approximate number of bytes used by the signal, including dynamically
+        allocated memory, but not the memory owned by the recorded arguments.
+        Allocator overhead isn't taken into account.
+        */
+        std::size_t memory_usage() const
+        {
+            return sizeof(*this) - sizeof(signal_t) + signal_t::memory_usage();
+        }
+};
+
+} //namespace
+
+#endif
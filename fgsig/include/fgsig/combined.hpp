@@ -0,0 +1,49 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_COMBINED_HPP
+#define FGSIG_COMBINED_HPP
+
+namespace fgsig
+{
+
+/*
+combined is a signal signature whose return type isn't void.
+Use it as a template parameter of signal:
+    fgsig::signal<fgsig::combined<int(int), fgsig::sum<int>>> sig;
+Calling emit() on such a signature returns the result of the given combiner,
+which is fed with the values returned by the slots.
+A combiner is a default-constructible type that provides:
+- bool operator()(R value), which is called with the value returned by each
+  slot, and which returns false to stop calling the remaining slots;
+- result(), whose return value is returned by emit().
+See combiners.hpp for the combiners provided by the library.
+*/
+template<typename Signature, typename Combiner>
+struct combined;
+
+namespace detail
+{
+    //Function type of the given signature
+    template<typename Signature>
+    struct function_signature
+    {
+        using type = Signature;
+    };
+
+    template<typename Signature, typename Combiner>
+    struct function_signature<combined<Signature, Combiner>>
+    {
+        using type = Signature;
+    };
+
+    template<typename Signature>
+    using function_signature_t = typename function_signature<Signature>::type;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,128 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_COMBINERS_HPP
+#define FGSIG_COMBINERS_HPP
+
+#include <optional>
+#include <utility>
+
+namespace fgsig
+{
+
+/*
+Combiners for combined signatures
+See combined.hpp.
+*/
+
+//Sum of the values returned by the slots (T{} if there is no slot)
+template<typename T>
+struct sum
+{
+    public:
+        bool operator()(const T& value)
+        {
+            result_ += value;
+            return true;
+        }
+
+        T result()
+        {
+            return std::move(result_);
+        }
+
+    private:
+        T result_{};
+};
+
+//Greatest value returned by the slots (empty if there is no slot)
+template<typename T>
+struct maximum
+{
+    public:
+        bool operator()(T value)
+        {
+            if(!result_ || *result_ < value)
+                result_ = std::move(value);
+            return true;
+        }
+
+        std::optional<T> result()
+        {
+            return std::move(result_);
+        }
+
+    private:
+        std::optional<T> result_;
+};
+
+//Whether all the slots return true (true if there is no slot)
+//Stops at the first slot that returns false.
+struct all_of
+{
+    public:
+        bool operator()(const bool value)
+        {
+            result_ = value;
+            return value;
+        }
+
+        bool result() const
+        {
+            return result_;
+        }
+
+    private:
+        bool result_ = true;
+};
+
+//Whether any slot returns true (false if there is no slot)
+//Stops at the first slot that returns true.
+struct any_of
+{
+    public:
+        bool operator()(const bool value)
+        {
+            result_ = value;
+            return !value;
+        }
+
+        bool result() const
+        {
+            return result_;
+        }
+
+    private:
+        bool result_ = false;
+};
+
+//First non-empty std::optional returned by the slots (empty if there is none)
+//Stops at the first slot that returns a non-empty std::optional.
+template<typename T>
+struct first_non_empty
+{
+    public:
+        bool operator()(std::optional<T> value)
+        {
+            if(!value)
+                return true;
+
+            result_ = std::move(value);
+            return false;
+        }
+
+        std::optional<T> result()
+        {
+            return std::move(result_);
+        }
+
+    private:
+        std::optional<T> result_;
+};
+
+} //namespace
+
+#endif
@@ -7,8 +7,14 @@
 #ifndef FGSIG_CONNECTION_HPP
 #define FGSIG_CONNECTION_HPP
 
+#include "signature_list.hpp"
+#include "combined.hpp"
 #include "detail/raw_closure.hpp"
-#include <tuple>
+#include "detail/raw_closure_id_set.hpp"
+#ifdef FGSIG_ENABLE_TRACING
+#include "tracing.hpp"
+#endif
+#include <type_traits>
 #include <utility>
 
 namespace fgsig
@@ -16,64 +22,193 @@ namespace fgsig
 
 namespace detail
 {
+    /*
+    Type of the object whose address is given to the raw closures of a slot
+    of type Slot.
+    */
+    template<typename Slot>
+    struct slot_object
+    {
+        using type = Slot;
+    };
+
+    template<typename Slot>
+    using slot_object_t = typename slot_object<Slot>::type;
+
     template<typename Slot, typename Signature>
     struct slot_caller;
 
-    template<typename Slot, typename... Args>
-    struct slot_caller<Slot, void(Args...)>
+    template<typename Slot, typename R, typename... Args>
+    struct slot_caller<Slot, R(Args...)>
     {
-        static void call(void* pvslot, Args... args)
+        static R call(void* pvslot, Args... args)
         {
+#ifdef FGSIG_ENABLE_TRACING
+            const auto trace = slot_call_trace<Slot>{};
+#endif
             auto& slot = *reinterpret_cast<Slot*>(pvslot);
-            slot(std::forward<Args>(args)...);
+            return slot(std::forward<Args>(args)...);
         }
     };
+
+    //Whether slot_caller<Slot, Signature> is well-formed
+    template<typename Slot, typename Signature>
+    struct is_slot_invocable;
+
+    template<typename Slot, typename R, typename... Args>
+    struct is_slot_invocable<Slot, R(Args...)>:
+        std::is_invocable_r<R, Slot&, Args...>
+    {
+    };
+
+    /*
+    signature_list of the signatures of the given signal that the given slot
+    can be called with
+    */
+    template<typename Signal, typename Slot>
+    struct invocable_signature_list;
+
+    template<template<typename...> typename SignalTpl, typename Slot, typename... Signatures>
+    struct invocable_signature_list<SignalTpl<Signatures...>, Slot>
+    {
+        using type = decltype
+        (
+            (
+                signature_list<>{} + ... +
+                std::conditional_t
+                <
+                    is_slot_invocable<Slot, function_signature_t<Signatures>>::value,
+                    signature_list<Signatures>,
+                    signature_list<>
+                >{}
+            )
+        );
+    };
+
+    template<typename Signal, typename Slot>
+    using invocable_signature_list_t = typename invocable_signature_list<Signal, Slot>::type;
+
+    //signature_list of all the signatures of the given signal
+    template<typename Signal>
+    struct signal_signature_list;
+
+    template<template<typename...> typename SignalTpl, typename... Signatures>
+    struct signal_signature_list<SignalTpl<Signatures...>>
+    {
+        using type = signature_list<Signatures...>;
+    };
+
+    template<typename Signal>
+    using signal_signature_list_t = typename signal_signature_list<Signal>::type;
+
+    struct inline_slot_tag{};
+
+    //Whether the given signature is one of the signatures of the given signal
+    template<typename Signal, typename Signature>
+    struct has_signature;
+
+    template<template<typename...> typename SignalTpl, typename... Signatures, typename Signature>
+    struct has_signature<SignalTpl<Signatures...>, Signature>:
+        std::bool_constant<(std::is_same_v<Signature, Signatures> || ...)>
+    {
+    };
 }
 
 /*
 connection establishes a connection between the given signal and slot.
 It doesn't own the given slot.
 Its destructor closes the connection.
+The slot is only connected to the signatures of SignatureList, which defaults
+to all the signatures of the signal.
 */
-template<typename Signal, typename Slot>
+template
+<
+    typename Signal,
+    typename Slot,
+    typename SignatureList = detail::signal_signature_list_t<Signal>
+>
 struct connection;
 
-template<template<typename...> typename SignalTpl, typename Slot, typename... Signatures>
-struct connection<SignalTpl<Signatures...>, Slot>
+template
+<
+    template<typename...> typename SignalTpl,
+    typename... SignalSignatures,
+    typename Slot,
+    typename... Signatures
+>
+struct connection<SignalTpl<SignalSignatures...>, Slot, signature_list<Signatures...>>
 {
+    static_assert(sizeof...(Signatures) != 0, "The slot can't be called with any signature of the signal.");
+
+    static_assert
+    (
+        (detail::has_signature<SignalTpl<SignalSignatures...>, Signatures>::value && ...),
+        "The given signatures must be signatures of the signal."
+    );
+
+    static_assert
+    (
+        (detail::is_slot_invocable<Slot, detail::function_signature_t<Signatures>>::value && ...),
+        "The slot can't be called with all the signatures it's connected to. Give fgsig::invocable_signatures to fgsig::connect() to only connect it to the signatures it can be called with."
+    );
+
     private:
-        template<typename Signal2, typename Slot2>
+        template<typename Signal2, typename Slot2, typename SignatureList2, bool InlineSlot>
         friend struct owning_connection;
 
-        using signal = SignalTpl<Signatures...>;
+        using signal = SignalTpl<SignalSignatures...>;
 
     public:
-        connection(signal& sig, Slot& slot):
+        connection(signal& sig, detail::slot_object_t<Slot>& slot):
             psignal_(&sig),
             event_closure_ids_
             (
-                std::make_tuple
+                psignal_->add_raw_event_closure
                 (
-                    psignal_->add_raw_event_closure
-                    (
-                        &detail::slot_caller<Slot, Signatures>::call,
-                        &slot
-                    )...
-                )
+                    &detail::slot_caller<Slot, detail::function_signature_t<Signatures>>::call,
+                    &slot
+                )...
+            ),
+            destruction_closure_id_(add_raw_destruction_closure())
+        {
+        }
+
+    private:
+        //Store a copy of the given slot in the closure (see owning_connection).
+        connection(signal& sig, const Slot& slot, detail::inline_slot_tag):
+            psignal_(&sig),
+            event_closure_ids_
+            (
+                psignal_->add_raw_event_closure_with_inline_slot
+                (
+                    &detail::slot_caller<Slot, detail::function_signature_t<Signatures>>::call,
+                    slot
+                )...
             ),
             destruction_closure_id_(add_raw_destruction_closure())
         {
         }
 
+    public:
         connection(const connection&) = delete;
 
+        /*
+        Move constructor:
+        Take over the closures of r, so that the slot keeps its position in
+        the call order. Nothing is allocated.
+        */
         connection(connection&& r):
             psignal_(r.psignal_),
             event_closure_ids_(std::move(r.event_closure_ids_)),
-            destruction_closure_id_(add_raw_destruction_closure())
+            destruction_closure_id_(r.destruction_closure_id_),
+            block_count_(r.block_count_)
         {
-            r.remove_raw_destruction_closure();
-            r.psignal_ = nullptr;
+            //Is r still open?
+            if(psignal_)
+            {
+                psignal_->repoint_raw_destruction_closure(destruction_closure_id_, this);
+                r.psignal_ = nullptr;
+            }
         }
 
         connection& operator=(const connection&) = delete;
@@ -95,7 +230,7 @@ struct connection<SignalTpl<Signatures...>, Slot>
                 (
                     psignal_->remove_raw_event_closure
                     (
-                        std::get<detail::raw_closure_id<Signatures>>(event_closure_ids_)
+                        event_closure_ids_.template get<Signatures>()
                     ),
                     ...
                 );
@@ -104,7 +239,63 @@ struct connection<SignalTpl<Signatures...>, Slot>
             }
         }
 
+        /*
+        Stop calling the slot until unblock() is called.
+        Calls to block() and unblock() must be balanced: the slot is called
+        again once unblock() has been called as many times as block().
+        Neither function allocates memory.
+        */
+        void block()
+        {
+            if(block_count_++ == 0 && psignal_)
+            {
+                (
+                    psignal_->block_raw_event_closure
+                    (
+                        event_closure_ids_.template get<Signatures>()
+                    ),
+                    ...
+                );
+            }
+        }
+
+        void unblock()
+        {
+            if(--block_count_ == 0 && psignal_)
+            {
+                (
+                    psignal_->unblock_raw_event_closure
+                    (
+                        event_closure_ids_.template get<Signatures>(),
+                        &detail::slot_caller<Slot, detail::function_signature_t<Signatures>>::call
+                    ),
+                    ...
+                );
+            }
+        }
+
+        bool blocked() const
+        {
+            return block_count_ != 0;
+        }
+
     private:
+        //Make the closures call the given slot (see owning_connection).
+        void repoint(detail::slot_object_t<Slot>& slot)
+        {
+            if(psignal_)
+            {
+                (
+                    psignal_->repoint_raw_event_closure
+                    (
+                        event_closure_ids_.template get<Signatures>(),
+                        &slot
+                    ),
+                    ...
+                );
+            }
+        }
+
         auto add_raw_destruction_closure()
         {
             return psignal_->add_raw_destruction_closure
@@ -133,12 +324,11 @@ struct connection<SignalTpl<Signatures...>, Slot>
         //Set to nullptr when connection is closed or moved from.
         signal* psignal_;
 
-        std::tuple
-        <
-            detail::raw_closure_id<Signatures>...
-        > event_closure_ids_;
+        detail::raw_closure_id_set<Signatures...> event_closure_ids_;
+
+        detail::raw_closure_id<detail::destruction_signature> destruction_closure_id_;
 
-        detail::raw_closure_id<void()> destruction_closure_id_;
+        unsigned int block_count_ = 0;
 };
 
 } //namespace
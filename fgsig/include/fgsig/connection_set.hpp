@@ -0,0 +1,173 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_CONNECTION_SET_HPP
+#define FGSIG_CONNECTION_SET_HPP
+
+#include "connection.hpp"
+#include "detail/raw_closure.hpp"
+#include "detail/raw_closure_id_set.hpp"
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace fgsig
+{
+
+/*
+connection_set establishes a connection between the given signal and each slot
+of the given range.
+It doesn't own the given slots.
+Its destructor closes all the connections.
+Compared to a collection of connection objects, it registers a single
+disconnection closure to the signal and stores the closure IDs in a single
+buffer.
+*/
+template
+<
+    typename Signal,
+    typename Slot,
+    typename SignatureList = detail::signal_signature_list_t<Signal>
+>
+struct connection_set;
+
+template
+<
+    template<typename...> typename SignalTpl,
+    typename... SignalSignatures,
+    typename Slot,
+    typename... Signatures
+>
+struct connection_set<SignalTpl<SignalSignatures...>, Slot, signature_list<Signatures...>>
+{
+    static_assert(sizeof...(Signatures) != 0, "The slots can't be called with any signature of the signal.");
+
+    static_assert
+    (
+        (detail::is_slot_invocable<Slot, detail::function_signature_t<Signatures>>::value && ...),
+        "The slots can't be called with all the signatures they're connected to. Give fgsig::invocable_signatures to fgsig::connect_many() to only connect them to the signatures they can be called with."
+    );
+
+    private:
+        using signal = SignalTpl<SignalSignatures...>;
+
+        using event_closure_id_set = detail::raw_closure_id_set<Signatures...>;
+
+    public:
+        template<typename Range>
+        connection_set(signal& sig, Range& slots):
+            psignal_(&sig)
+        {
+            const auto first = std::begin(slots);
+            const auto last = std::end(slots);
+
+            event_closure_ids_.reserve(std::distance(first, last));
+            for(auto it = first; it != last; ++it)
+            {
+                Slot& slot = *it;
+                event_closure_ids_.emplace_back
+                (
+                    psignal_->add_raw_event_closure
+                    (
+                        &detail::slot_caller<Slot, detail::function_signature_t<Signatures>>::call,
+                        &slot
+                    )...
+                );
+            }
+
+            disconnection_closure_id_ = add_raw_disconnection_closure();
+        }
+
+        connection_set(const connection_set&) = delete;
+
+        connection_set(connection_set&& r):
+            psignal_(r.psignal_),
+            event_closure_ids_(std::move(r.event_closure_ids_)),
+            disconnection_closure_id_(r.disconnection_closure_id_)
+        {
+            if(psignal_)
+            {
+                psignal_->repoint_raw_disconnection_closure(disconnection_closure_id_, this);
+                r.psignal_ = nullptr;
+            }
+        }
+
+        connection_set& operator=(const connection_set&) = delete;
+
+        connection_set& operator=(connection_set&&) = delete;
+
+        ~connection_set()
+        {
+            close();
+        }
+
+        //Number of connected slots
+        std::size_t size() const
+        {
+            return psignal_ ? event_closure_ids_.size() : 0;
+        }
+
+        void close()
+        {
+            if(psignal_)
+            {
+                remove_raw_disconnection_closure();
+
+                //Remove event closure of each slot and signature.
+                for(const auto& ids: event_closure_ids_)
+                {
+                    (
+                        psignal_->remove_raw_event_closure
+                        (
+                            ids.template get<Signatures>()
+                        ),
+                        ...
+                    );
+                }
+
+                event_closure_ids_.clear();
+                psignal_ = nullptr;
+            }
+        }
+
+    private:
+        auto add_raw_disconnection_closure()
+        {
+            return psignal_->add_raw_disconnection_closure
+            (
+                &on_disconnection,
+                this
+            );
+        }
+
+        void remove_raw_disconnection_closure()
+        {
+            psignal_->remove_raw_disconnection_closure
+            (
+                disconnection_closure_id_
+            );
+        }
+
+        static void on_disconnection(void* pvself)
+        {
+            auto& self = *reinterpret_cast<connection_set*>(pvself);
+            self.psignal_ = nullptr;
+        }
+
+    private:
+        //Pointer to signal.
+        //Set to nullptr when connection set is closed, disconnected or moved
+        //from.
+        signal* psignal_;
+
+        std::vector<event_closure_id_set> event_closure_ids_;
+
+        detail::raw_closure_id<detail::destruction_signature> disconnection_closure_id_;
+};
+
+} //namespace
+
+#endif
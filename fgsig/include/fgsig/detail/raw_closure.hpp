@@ -8,13 +8,89 @@
 #define FGSIG_DETAIL_RAW_CLOSURE_HPP
 
 #include "voidp_function_ptr.hpp"
+#include "../grouped.hpp"
+#include <cstddef>
 #include <list>
+#include <type_traits>
 
 namespace fgsig::detail
 {
 
+//Signature of the closures that notify connections of the destruction of a
+//signal
+struct destruction_signature;
+
+template<>
+struct function_signature<destruction_signature>
+{
+    using type = void();
+};
+
+/*
+Size of the storage of raw_closure for small slots
+It's zero unless the signature is wrapped into fgsig::inline_slots (see
+inline_slots.hpp), so that closures are only as large as two pointers by
+default.
+*/
+template<typename Signature>
+struct inline_slot_capacity
+{
+    static constexpr std::size_t value = 0;
+};
+
+/*
+Whether a slot of type Slot can be stored in a raw_closure of the given
+signature.
+The slot is never moved nor destroyed, so it must be trivially copyable.
+*/
+template<typename Slot, typename Signature>
+struct is_inline_slot
+{
+    static constexpr bool value =
+        sizeof(Slot) <= inline_slot_capacity<Signature>::value &&
+        alignof(Slot) <= alignof(void*) &&
+        std::is_trivially_copyable_v<Slot>
+    ;
+};
+
+/*
+Base of raw_closure
+For grouped signatures, it holds the function of the slot, which identifies the
+group of the closure (see closure_groups) even once pf has been changed to
+block the closure or to mark it as removed. It's empty otherwise.
+*/
+template<typename Signature, bool Grouped = is_grouped<Signature>::value>
+struct raw_closure_base
+{
+};
+
+template<typename Signature>
+struct raw_closure_base<Signature, true>
+{
+    voidp_function_ptr<Signature> group_pf = nullptr;
+};
+
+/*
+raw_closure holds the function to call and the address of the slot.
+Small owned slots are stored in the closure itself (in slot_storage) so that
+emit() doesn't have to look further than the closure.
+*/
+template<typename Signature, std::size_t InlineSlotCapacity = inline_slot_capacity<Signature>::value>
+struct raw_closure: raw_closure_base<Signature>
+{
+    raw_closure(const voidp_function_ptr<Signature> pf, void* const pvslot):
+        pf(pf),
+        pvslot(pvslot)
+    {
+    }
+
+    voidp_function_ptr<Signature> pf;
+    void* pvslot;
+    alignas(void*) unsigned char slot_storage[InlineSlotCapacity];
+};
+
 template<typename Signature>
-struct raw_closure
+struct raw_closure<Signature, 0>: raw_closure_base<Signature>
 {
     raw_closure(const voidp_function_ptr<Signature> pf, void* const pvslot):
         pf(pf),
@@ -30,7 +106,14 @@ template<typename Signature>
 using raw_closure_list = std::list<raw_closure<Signature>>;
 
 template<typename Signature>
-using raw_closure_id = typename raw_closure_list<Signature>::iterator;
+struct raw_closure_id
+{
+    typename raw_closure_list<Signature>::iterator it;
+
+    //Generation of the closure list when the closure was added.
+    //The ID is stale if the list has been cleared since.
+    std::size_t generation = 0;
+};
 
 } //namespace
 
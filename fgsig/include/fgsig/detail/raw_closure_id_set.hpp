@@ -0,0 +1,44 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_DETAIL_RAW_CLOSURE_ID_SET_HPP
+#define FGSIG_DETAIL_RAW_CLOSURE_ID_SET_HPP
+
+#include "raw_closure.hpp"
+
+namespace fgsig::detail
+{
+
+template<typename Signature>
+struct raw_closure_id_holder
+{
+    raw_closure_id<Signature> id;
+};
+
+/*
+raw_closure_id_set holds one raw_closure_id per signature.
+It's a flat alternative to std::tuple<raw_closure_id<Signatures>...>, whose
+instantiation cost grows faster with the number of signatures.
+Signatures must be unique.
+*/
+template<typename... Signatures>
+struct raw_closure_id_set: raw_closure_id_holder<Signatures>...
+{
+    raw_closure_id_set(const raw_closure_id<Signatures>... ids):
+        raw_closure_id_holder<Signatures>{ids}...
+    {
+    }
+
+    template<typename Signature>
+    raw_closure_id<Signature> get() const
+    {
+        return static_cast<const raw_closure_id_holder<Signature>&>(*this).id;
+    }
+};
+
+} //namespace
+
+#endif
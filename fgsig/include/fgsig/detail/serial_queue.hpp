@@ -0,0 +1,173 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_DETAIL_SERIAL_QUEUE_HPP
+#define FGSIG_DETAIL_SERIAL_QUEUE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace fgsig::detail
+{
+
+/*
+serial_queue runs the given tasks one after the other, in FIFO order, on the
+given executor.
+At most one task of the queue is posted to the executor at a time. This task
+runs all the tasks that are pending when it starts.
+Posted tasks hold a shared pointer to the queue, so serial_queue objects must
+be created with std::make_shared. The executor must outlive the queue.
+If a task throws, the exception propagates to the executor (out of the
+function it has been given), once the queue is ready to run the next tasks.
+These tasks are then run by another function posted to the executor.
+*/
+template<typename Executor>
+struct serial_queue: std::enable_shared_from_this<serial_queue<Executor>>
+{
+    public:
+        serial_queue(Executor& executor):
+            executor_(executor)
+        {
+        }
+
+        serial_queue(const serial_queue&) = delete;
+
+        serial_queue(serial_queue&&) = delete;
+
+        serial_queue& operator=(const serial_queue&) = delete;
+
+        serial_queue& operator=(serial_queue&&) = delete;
+
+        //Do nothing if the queue is closed.
+        void post(std::function<void()> task)
+        {
+            {
+                const auto lock = std::lock_guard<std::mutex>{mutex_};
+
+                if(closed_)
+                    return;
+
+                pending_tasks_.push_back(std::move(task));
+
+                //Is a run() already posted to the executor?
+                if(running_)
+                    return;
+
+                running_ = true;
+            }
+
+            post_run();
+        }
+
+        /*
+        Discard the pending tasks, ignore the ones that are posted later, and
+        wait for the task that is currently running (if any) to finish.
+        If close() is called by the running task itself, it doesn't wait.
+        */
+        void close()
+        {
+            auto lock = std::unique_lock<std::mutex>{mutex_};
+
+            closed_ = true;
+            pending_tasks_.clear();
+
+            const auto this_thread_id = std::this_thread::get_id();
+            idle_.wait
+            (
+                lock,
+                [this, this_thread_id]
+                {
+                    return
+                        task_thread_id_ == std::thread::id{} ||
+                        task_thread_id_ == this_thread_id
+                    ;
+                }
+            );
+        }
+
+    private:
+        void post_run()
+        {
+            executor_.post
+            (
+                [pself = this->shared_from_this()]
+                {
+                    pself->run();
+                }
+            );
+        }
+
+        void run()
+        {
+            auto lock = std::unique_lock<std::mutex>{mutex_};
+
+            while(!closed_ && !pending_tasks_.empty())
+            {
+                auto task = std::move(pending_tasks_.front());
+                pending_tasks_.pop_front();
+
+                task_thread_id_ = std::this_thread::get_id();
+                lock.unlock();
+
+                try
+                {
+                    task();
+                }
+                catch(...)
+                {
+                    task = nullptr;
+
+                    lock.lock();
+                    task_thread_id_ = std::thread::id{};
+                    idle_.notify_all();
+
+                    //Let another run() deliver the remaining tasks.
+                    const auto rerun = !closed_ && !pending_tasks_.empty();
+                    running_ = rerun;
+                    lock.unlock();
+
+                    if(rerun)
+                        post_run();
+
+                    throw;
+                }
+
+                //Release what the task holds (such as the last reference to
+                //an async_slot) before taking the lock.
+                task = nullptr;
+
+                lock.lock();
+                task_thread_id_ = std::thread::id{};
+                idle_.notify_all();
+            }
+
+            running_ = false;
+        }
+
+    private:
+        Executor& executor_;
+
+        std::mutex mutex_;
+        std::condition_variable idle_;
+        std::deque<std::function<void()>> pending_tasks_;
+
+        //Whether a run() is posted to the executor
+        bool running_ = false;
+
+        bool closed_ = false;
+
+        //ID of the thread that is running a task, if any
+        std::thread::id task_thread_id_;
+};
+
+} //namespace
+
+#endif
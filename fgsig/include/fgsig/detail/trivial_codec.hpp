@@ -0,0 +1,136 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_DETAIL_TRIVIAL_CODEC_HPP
+#define FGSIG_DETAIL_TRIVIAL_CODEC_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace fgsig::detail
+{
+
+/*
+trivial_codec converts the trivially copyable arguments of a signature from and
+to bytes.
+Bytes are in native format, so they're only meant to be read by the same
+platform.
+*/
+
+template<typename Signature>
+struct trivial_codec;
+
+template<typename R, typename... Args>
+struct trivial_codec<R(Args...)>
+{
+    static_assert(std::is_same_v<R, void>, "The return type of the signature must be void.");
+
+    static_assert
+    (
+        (std::is_trivially_copyable_v<std::decay_t<Args>> && ...),
+        "The argument types of the signature must be trivially copyable."
+    );
+
+    static_assert
+    (
+        ((alignof(std::decay_t<Args>) <= alignof(std::max_align_t)) && ...),
+        "The argument types of the signature must not be over-aligned."
+    );
+
+    private:
+        static constexpr auto offsets = []
+        {
+            auto offsets = std::array<std::size_t, sizeof...(Args) + 1>{};
+            auto offset = std::size_t{0};
+            auto i = std::size_t{0};
+            (
+                (
+                    offset = (offset + alignof(std::decay_t<Args>) - 1) / alignof(std::decay_t<Args>) * alignof(std::decay_t<Args>),
+                    offsets[i++] = offset,
+                    offset += sizeof(std::decay_t<Args>)
+                ),
+                ...
+            );
+            offsets[i] = offset;
+            return offsets;
+        }();
+
+    public:
+        //Number of bytes needed to store the arguments
+        static constexpr std::size_t size = offsets[sizeof...(Args)];
+
+        static void write(unsigned char* const buffer, const std::decay_t<Args>&... args)
+        {
+            write_impl(buffer, std::index_sequence_for<Args...>{}, args...);
+        }
+
+        //Emit the arguments stored in the given buffer.
+        template<typename Signal>
+        static void emit(Signal& sig, unsigned char* const buffer)
+        {
+            emit_impl(sig, buffer, std::index_sequence_for<Args...>{});
+        }
+
+    private:
+        template<std::size_t... Indexes>
+        static void write_impl(unsigned char* const buffer, std::index_sequence<Indexes...>, const std::decay_t<Args>&... args)
+        {
+            (std::memcpy(buffer + offsets[Indexes], &args, sizeof(args)), ...);
+        }
+
+        template<typename Signal, std::size_t... Indexes>
+        static void emit_impl(Signal& sig, unsigned char* const buffer, std::index_sequence<Indexes...>)
+        {
+            //The buffer has been filled with the bytes of trivially
+            //copyable objects, at suitably aligned offsets.
+            sig.emit
+            (
+                std::forward<Args>
+                (
+                    *std::launder(reinterpret_cast<std::decay_t<Args>*>(buffer + offsets[Indexes]))
+                )...
+            );
+        }
+};
+
+/*
+Emit, through the given signal, the arguments of the signature of the given
+index that are stored in the given buffer.
+*/
+template<typename... Signatures, typename Signal, std::size_t... Indexes>
+void trivial_codec_emit_impl(Signal& sig, const std::size_t signature_index, unsigned char* const buffer, std::index_sequence<Indexes...>)
+{
+    (
+        (
+            signature_index == Indexes ?
+            trivial_codec<Signatures>::emit(sig, buffer) :
+            void()
+        ),
+        ...
+    );
+}
+
+template<typename... Signatures, typename Signal>
+void trivial_codec_emit(Signal& sig, const std::size_t signature_index, unsigned char* const buffer)
+{
+    trivial_codec_emit_impl<Signatures...>(sig, signature_index, buffer, std::index_sequence_for<Signatures...>{});
+}
+
+template<std::size_t... Sizes>
+constexpr std::size_t max_size()
+{
+    auto result = std::size_t{0};
+    ((result = Sizes > result ? Sizes : result), ...);
+    return result;
+}
+
+} //namespace
+
+#endif
@@ -7,6 +7,8 @@
 #ifndef FGSIG_DETAIL_VOIDP_FUNCTION_PTR_HPP
 #define FGSIG_DETAIL_VOIDP_FUNCTION_PTR_HPP
 
+#include "../combined.hpp"
+
 namespace fgsig::detail
 {
 
@@ -24,7 +26,7 @@ Metafunction voidp_function_ptr returns a function pointer type whose signature
 corresponds to the one given as template parameter, prepended with a void*.
 */
 template<typename Signature>
-using voidp_function_ptr = typename voidp_function_ptr_helper<Signature>::type;
+using voidp_function_ptr = typename voidp_function_ptr_helper<function_signature_t<Signature>>::type;
 
 } //namespace
 
@@ -0,0 +1,124 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_DETAIL_WORKER_THREADS_HPP
+#define FGSIG_DETAIL_WORKER_THREADS_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace fgsig::detail
+{
+
+inline std::size_t default_thread_count()
+{
+    const auto count = std::thread::hardware_concurrency();
+    return count != 0 ? count : 1;
+}
+
+/*
+worker_threads calls the given worker function on a fixed number of threads,
+with the index of the thread (from 0 to size() - 1) as argument.
+Workers wait for work with wait(), and must return once stopping() is true.
+The destructor sets stopping(), wakes the workers up and joins them, so the
+owner must declare its worker_threads after the members its workers use.
+*/
+class worker_threads
+{
+    public:
+        template<typename Worker>
+        worker_threads(const std::size_t thread_count, Worker worker)
+        {
+            if(thread_count == 0)
+                throw std::invalid_argument{"fgsig: the thread count must not be zero"};
+
+            threads_.reserve(thread_count);
+            try
+            {
+                for(auto i = std::size_t{0}; i < thread_count; ++i)
+                    threads_.emplace_back([worker, i]{worker(i);});
+            }
+            catch(...)
+            {
+                stop();
+                throw;
+            }
+        }
+
+        worker_threads(const worker_threads&) = delete;
+
+        worker_threads(worker_threads&&) = delete;
+
+        worker_threads& operator=(const worker_threads&) = delete;
+
+        worker_threads& operator=(worker_threads&&) = delete;
+
+        ~worker_threads()
+        {
+            stop();
+        }
+
+        //Protects stopping() and whatever the owner's workers wait for.
+        std::mutex& mutex()
+        {
+            return mutex_;
+        }
+
+        //Wait until the given predicate is true or stopping() is true.
+        template<typename Predicate>
+        void wait(std::unique_lock<std::mutex>& lock, Predicate&& predicate)
+        {
+            work_available_.wait(lock, [&]{return stopping_ || predicate();});
+        }
+
+        //Must be called with mutex() locked.
+        bool stopping() const
+        {
+            return stopping_;
+        }
+
+        void notify_one()
+        {
+            work_available_.notify_one();
+        }
+
+        void notify_all()
+        {
+            work_available_.notify_all();
+        }
+
+        std::size_t size() const
+        {
+            return threads_.size();
+        }
+
+    private:
+        void stop()
+        {
+            {
+                const auto lock = std::lock_guard<std::mutex>{mutex_};
+                stopping_ = true;
+            }
+            work_available_.notify_all();
+
+            for(auto& t: threads_)
+                t.join();
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable work_available_;
+        bool stopping_ = false;
+        std::vector<std::thread> threads_;
+};
+
+} //namespace
+
+#endif
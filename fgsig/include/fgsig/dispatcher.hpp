@@ -0,0 +1,457 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_DISPATCHER_HPP
+#define FGSIG_DISPATCHER_HPP
+
+#include "detail/worker_threads.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    constexpr std::size_t round_up_to_max_alignment(const std::size_t size)
+    {
+        constexpr auto alignment = alignof(std::max_align_t);
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    /*
+    emission_buffer holds the emissions of a single signal, in order.
+    Each emission is a tuple of the copied arguments, constructed in place next
+    to a header that knows how to emit and destroy it. The memory blocks are
+    kept by clear(), so that a buffer that is reused for every batch stops
+    allocating once it's large enough.
+    */
+    class emission_buffer
+    {
+        private:
+            struct record_header
+            {
+                void(*pemit)(void* psig, void* pargs);
+                void(*pdestroy)(void* pargs);
+                std::size_t size;
+            };
+
+            struct block
+            {
+                std::unique_ptr<unsigned char[]> pdata;
+                std::size_t capacity;
+                std::size_t size;
+            };
+
+            static constexpr auto alignment = alignof(std::max_align_t);
+
+            static constexpr auto header_size = round_up_to_max_alignment(sizeof(record_header));
+
+            static constexpr auto min_block_size = std::size_t{1024};
+
+        public:
+            emission_buffer() = default;
+
+            emission_buffer(const emission_buffer&) = delete;
+
+            emission_buffer(emission_buffer&&) = default;
+
+            emission_buffer& operator=(const emission_buffer&) = delete;
+
+            emission_buffer& operator=(emission_buffer&&) = delete;
+
+            ~emission_buffer()
+            {
+                clear();
+            }
+
+            template<typename Signal, typename... Args>
+            void add(Args&&... args)
+            {
+                using arg_tuple = std::tuple<std::decay_t<Args>...>;
+
+                static_assert(alignof(arg_tuple) <= alignment, "Over-aligned arguments aren't supported.");
+
+                constexpr auto record_size = header_size + round_up_to_max_alignment(sizeof(arg_tuple));
+
+                auto& b = block_with_room_for(record_size);
+                const auto precord = b.pdata.get() + b.size;
+
+                //If a copy throws, the record is just not committed.
+                new(precord + header_size) arg_tuple{std::forward<Args>(args)...};
+
+                new(precord) record_header
+                {
+                    &emit_record<Signal, arg_tuple>,
+                    &destroy_record<arg_tuple>,
+                    record_size
+                };
+                b.size += record_size;
+            }
+
+            /*
+            Emit the stored emissions in order on the given signal, then clear
+            the buffer.
+            If an emission throws, the given exception handler is called from
+            the catch block, and the next emissions are still made.
+            */
+            template<typename ExceptionHandler>
+            void emit_and_clear(void* psig, ExceptionHandler&& handle_exception)
+            {
+                for_each_record
+                (
+                    [&](record_header& header, void* pargs)
+                    {
+                        try
+                        {
+                            header.pemit(psig, pargs);
+                        }
+                        catch(...)
+                        {
+                            handle_exception();
+                        }
+                        header.pdestroy(pargs);
+                    }
+                );
+                reset();
+            }
+
+            //Destroy the stored emissions, but keep the memory.
+            void clear()
+            {
+                for_each_record
+                (
+                    [](record_header& header, void* pargs)
+                    {
+                        header.pdestroy(pargs);
+                    }
+                );
+                reset();
+            }
+
+        private:
+            template<typename Signal, typename ArgTuple>
+            static void emit_record(void* psig, void* pargs)
+            {
+                std::apply
+                (
+                    [psig](auto&... values)
+                    {
+                        static_cast<Signal*>(psig)->emit(std::move(values)...);
+                    },
+                    *static_cast<ArgTuple*>(pargs)
+                );
+            }
+
+            template<typename ArgTuple>
+            static void destroy_record(void* pargs)
+            {
+                static_cast<ArgTuple*>(pargs)->~ArgTuple();
+            }
+
+            //Return the current block if it has room for the given size, or
+            //the next block that has (which becomes the current one).
+            block& block_with_room_for(const std::size_t size)
+            {
+                while(current_block_ < blocks_.size())
+                {
+                    auto& b = blocks_[current_block_];
+                    if(b.capacity - b.size >= size)
+                        return b;
+                    ++current_block_;
+                }
+
+                const auto capacity = std::max
+                ({
+                    min_block_size,
+                    size,
+                    blocks_.empty() ? std::size_t{0} : 2 * blocks_.back().capacity
+                });
+                blocks_.push_back(block{std::make_unique<unsigned char[]>(capacity), capacity, 0});
+                return blocks_.back();
+            }
+
+            template<typename F>
+            void for_each_record(F&& f)
+            {
+                for(auto& b: blocks_)
+                {
+                    for(auto offset = std::size_t{0}; offset < b.size;)
+                    {
+                        auto& header = *std::launder(reinterpret_cast<record_header*>(b.pdata.get() + offset));
+                        offset += header.size;
+                        f(header, static_cast<void*>(reinterpret_cast<unsigned char*>(&header) + header_size));
+                    }
+                }
+            }
+
+            void reset()
+            {
+                for(auto& b: blocks_)
+                    b.size = 0;
+                current_block_ = 0;
+            }
+
+        private:
+            std::vector<block> blocks_;
+            std::size_t current_block_ = 0;
+    };
+}
+
+/*
+emit_batch holds emissions to be delivered by a dispatcher.
+The emissions of a given signal are grouped, in the order they've been added.
+The arguments are copied or moved into the batch.
+The memory of the batch is kept by clear() (and then by dispatcher::run()), so
+that reusing the same batch doesn't allocate once it's large enough.
+*/
+struct emit_batch
+{
+    private:
+        friend struct dispatcher;
+
+        struct group
+        {
+            void* psig;
+            detail::emission_buffer emissions;
+        };
+
+    public:
+        /*
+        Add an emission of the given signal, or of any object that has an emit()
+        member function (such as a signal_array).
+        The signal must outlive the delivery of the batch.
+        */
+        template<typename Signal, typename... Args>
+        void add(Signal& sig, Args&&... args)
+        {
+            const auto result = group_indexes_.try_emplace(&sig, group_count_);
+            if(result.second)
+            {
+                //Reuse the group (and its memory) of a previous batch if any.
+                if(group_count_ == groups_.size())
+                {
+                    try
+                    {
+                        groups_.push_back(group{&sig, {}});
+                    }
+                    catch(...)
+                    {
+                        group_indexes_.erase(result.first);
+                        throw;
+                    }
+                }
+                else
+                {
+                    groups_[group_count_].psig = &sig;
+                }
+                ++group_count_;
+            }
+
+            groups_[result.first->second].emissions.template add<Signal>(std::forward<Args>(args)...);
+        }
+
+        bool empty() const
+        {
+            return group_count_ == 0;
+        }
+
+        void clear()
+        {
+            for(auto i = std::size_t{0}; i < group_count_; ++i)
+                groups_[i].emissions.clear();
+            group_indexes_.clear();
+            group_count_ = 0;
+        }
+
+    private:
+        std::unordered_map<const void*, std::size_t> group_indexes_;
+
+        //Only the first group_count_ groups are in use.
+        std::vector<group> groups_;
+        std::size_t group_count_ = 0;
+};
+
+/*
+dispatcher delivers batches of emissions on a pool of threads.
+Each signal is given to a single thread, which emits its events in order.
+Different signals are emitted in parallel. Each thread has its own queue of
+signals, and steals from the queues of the other threads when its own is empty.
+Since a signal is only used by one thread at a time, the usual rules of
+reentrancy and of disconnection during emission apply. However, the slots of
+different signals may run concurrently, so they must synchronize any state
+they share (including other signals).
+*/
+struct dispatcher
+{
+    public:
+        //Throw std::invalid_argument if the given number of threads is zero.
+        explicit dispatcher(const std::size_t thread_count = detail::default_thread_count()):
+            queues_(thread_count),
+            workers_(thread_count, [this](const std::size_t i){run_worker(i);})
+        {
+        }
+
+        dispatcher(const dispatcher&) = delete;
+
+        dispatcher(dispatcher&&) = delete;
+
+        dispatcher& operator=(const dispatcher&) = delete;
+
+        dispatcher& operator=(dispatcher&&) = delete;
+
+        /*
+        Deliver the emissions of the given batch, wait until they're all done,
+        and clear the batch.
+        If slots throw, the remaining emissions are still delivered, then the
+        first exception is rethrown.
+        Must not be called concurrently, nor by a slot of a delivered signal.
+        */
+        void run(emit_batch& batch)
+        {
+            if(batch.empty())
+                return;
+
+            pbatch_ = &batch;
+            remaining_group_count_ = batch.group_count_;
+
+            //Distribute the groups among the queues.
+            for(auto i = std::size_t{0}; i < batch.group_count_; ++i)
+            {
+                auto& q = queues_[i % queues_.size()];
+                const auto lock = std::lock_guard<std::mutex>{q.mutex};
+                q.group_indexes.push_back(i);
+            }
+
+            {
+                auto lock = std::unique_lock<std::mutex>{workers_.mutex()};
+                ++generation_;
+                workers_.notify_all();
+                done_.wait(lock, [this]{return remaining_group_count_ == 0;});
+            }
+
+            pbatch_ = nullptr;
+            batch.clear();
+
+            if(pexception_)
+                std::rethrow_exception(std::exchange(pexception_, nullptr));
+        }
+
+        //Number of threads
+        std::size_t size() const
+        {
+            return workers_.size();
+        }
+
+    private:
+        struct work_queue
+        {
+            std::mutex mutex;
+            std::deque<std::size_t> group_indexes;
+        };
+
+        void run_worker(const std::size_t worker_index)
+        {
+            auto seen_generation = std::size_t{0};
+            while(true)
+            {
+                {
+                    auto lock = std::unique_lock<std::mutex>{workers_.mutex()};
+                    workers_.wait(lock, [&]{return generation_ != seen_generation;});
+                    if(workers_.stopping())
+                        return;
+                    seen_generation = generation_;
+                }
+
+                auto group_index = std::size_t{0};
+                while(pop_group(worker_index, group_index))
+                    run_group(group_index);
+            }
+        }
+
+        //Pop a group from the back of our queue, or steal one from the front of
+        //another queue.
+        bool pop_group(const std::size_t worker_index, std::size_t& group_index)
+        {
+            {
+                auto& q = queues_[worker_index];
+                const auto lock = std::lock_guard<std::mutex>{q.mutex};
+                if(!q.group_indexes.empty())
+                {
+                    group_index = q.group_indexes.back();
+                    q.group_indexes.pop_back();
+                    return true;
+                }
+            }
+
+            for(auto i = std::size_t{1}; i < queues_.size(); ++i)
+            {
+                auto& q = queues_[(worker_index + i) % queues_.size()];
+                const auto lock = std::lock_guard<std::mutex>{q.mutex};
+                if(!q.group_indexes.empty())
+                {
+                    group_index = q.group_indexes.front();
+                    q.group_indexes.pop_front();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void run_group(const std::size_t group_index)
+        {
+            auto& g = pbatch_->groups_[group_index];
+            g.emissions.emit_and_clear
+            (
+                g.psig,
+                [this]
+                {
+                    const auto lock = std::lock_guard<std::mutex>{workers_.mutex()};
+                    if(!pexception_)
+                        pexception_ = std::current_exception();
+                }
+            );
+
+            if(remaining_group_count_.fetch_sub(1) == 1)
+            {
+                const auto lock = std::lock_guard<std::mutex>{workers_.mutex()};
+                done_.notify_all();
+            }
+        }
+
+    private:
+        std::vector<work_queue> queues_;
+
+        std::condition_variable done_;
+
+        //Incremented by run(), so that workers look for work. Protected by
+        //workers_.mutex(), as pexception_.
+        std::size_t generation_ = 0;
+
+        emit_batch* pbatch_ = nullptr;
+        std::atomic<std::size_t> remaining_group_count_{0};
+        std::exception_ptr pexception_;
+
+        //Declared last, so that the threads are joined first.
+        detail::worker_threads workers_;
+};
+
+} //namespace
+
+#endif
@@ -0,0 +1,297 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_EMISSION_RECORDER_HPP
+#define FGSIG_EMISSION_RECORDER_HPP
+
+#include "signal.hpp"
+#include "detail/trivial_codec.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    /*
+    Format of emission logs (in native byte order):
+    - header:
+        - magic string (8 bytes);
+        - format version (uint32);
+        - number of signatures (uint32);
+        - payload size of each signature (uint32 each);
+    - records:
+        - signature index (uint32);
+        - timestamp, in ns since the construction of the recorder (int64);
+        - payload (size of the payload of the signature).
+    */
+
+    constexpr char emission_log_magic[8] = {'F', 'G', 'S', 'I', 'G', 'L', 'O', 'G'};
+    constexpr std::uint32_t emission_log_version = 1;
+
+    template<typename T>
+    void write_value(std::ostream& out, const T value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template<typename T>
+    bool read_value(std::istream& in, T& value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    template<typename Derived, std::size_t Index, typename Signature>
+    struct emission_recorder_leaf;
+
+    template<typename Derived, std::size_t Index, typename... Args>
+    struct emission_recorder_leaf<Derived, Index, void(Args...)>
+    {
+        public:
+            void operator()(Args... args)
+            {
+                using codec = trivial_codec<void(Args...)>;
+
+                static_cast<Derived&>(*this).record
+                (
+                    Index,
+                    codec::size,
+                    [&args...](unsigned char* const buffer)
+                    {
+                        codec::write(buffer, args...);
+                    }
+                );
+            }
+    };
+
+    template<typename Derived, typename IndexSequence, typename... Signatures>
+    struct emission_recorder_base;
+
+    template<typename Derived, std::size_t... Indexes, typename... Signatures>
+    struct emission_recorder_base<Derived, std::index_sequence<Indexes...>, Signatures...>:
+        public emission_recorder_leaf<Derived, Indexes, Signatures>...
+    {
+        public:
+            using emission_recorder_leaf<Derived, Indexes, Signatures>::operator()...;
+    };
+
+    template<std::size_t PayloadSize>
+    struct emission_payload_buffer
+    {
+        alignas(std::max_align_t) unsigned char bytes[PayloadSize > 0 ? PayloadSize : 1];
+    };
+}
+
+/*
+emission_recorder writes the signature index, the timestamp and the arguments
+of every emission of the given signal into the given binary stream, from its
+construction to its destruction.
+The argument types of the signal must be trivially copyable.
+Emissions made by slots during another emission of the signal (of any
+signature) aren't recorded, since replaying the outer emission makes them
+again.
+The log is meant to be read back with emission_log, on the same platform.
+*/
+template<typename Signal>
+struct emission_recorder;
+
+template<typename... Signatures>
+struct emission_recorder<signal<Signatures...>>:
+    public detail::emission_recorder_base
+    <
+        emission_recorder<signal<Signatures...>>,
+        std::index_sequence_for<Signatures...>,
+        Signatures...
+    >
+{
+    private:
+        template<typename Derived, std::size_t Index, typename Signature>
+        friend struct detail::emission_recorder_leaf;
+
+        using signal_t = signal<Signatures...>;
+        using clock = std::chrono::steady_clock;
+
+    public:
+        emission_recorder(signal_t& sig, std::ostream& out):
+            sig_(sig),
+            out_(out),
+            start_time_(clock::now()),
+            connection_(sig, *this)
+        {
+            out_.write(detail::emission_log_magic, sizeof(detail::emission_log_magic));
+            detail::write_value(out_, detail::emission_log_version);
+            detail::write_value(out_, static_cast<std::uint32_t>(sizeof...(Signatures)));
+            (detail::write_value(out_, static_cast<std::uint32_t>(detail::trivial_codec<Signatures>::size)), ...);
+        }
+
+        emission_recorder(const emission_recorder&) = delete;
+
+        emission_recorder(emission_recorder&&) = delete;
+
+        emission_recorder& operator=(const emission_recorder&) = delete;
+
+        emission_recorder& operator=(emission_recorder&&) = delete;
+
+    private:
+        template<typename WriteFn>
+        void record(const std::size_t signature_index, const std::size_t payload_size, WriteFn&& write_payload)
+        {
+            if(sig_.emission_depth() > 1)
+                return;
+
+            const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (
+                clock::now() - start_time_
+            ).count();
+
+            auto buffer = detail::emission_payload_buffer<detail::max_size<detail::trivial_codec<Signatures>::size...>()>{};
+            write_payload(buffer.bytes);
+
+            detail::write_value(out_, static_cast<std::uint32_t>(signature_index));
+            detail::write_value(out_, static_cast<std::int64_t>(timestamp));
+            out_.write(reinterpret_cast<const char*>(buffer.bytes), payload_size);
+        }
+
+    private:
+        signal_t& sig_;
+        std::ostream& out_;
+        clock::time_point start_time_;
+        connection<signal_t, emission_recorder> connection_;
+};
+
+enum class replay_speed
+{
+    //Wait between emissions as long as they were apart when recorded.
+    recorded,
+
+    //Don't wait between emissions.
+    maximum
+};
+
+/*
+emission_log holds the records written by an emission_recorder, and replays
+them through a signal.
+Reading the whole log first lets replay() run without any I/O.
+*/
+template<typename Signal>
+struct emission_log;
+
+template<typename... Signatures>
+struct emission_log<signal<Signatures...>>
+{
+    private:
+        using signal_t = signal<Signatures...>;
+
+        using payload_buffer = detail::emission_payload_buffer
+        <
+            detail::max_size<detail::trivial_codec<Signatures>::size...>()
+        >;
+
+        struct record
+        {
+            std::uint32_t signature_index;
+            std::chrono::nanoseconds timestamp;
+            payload_buffer payload;
+        };
+
+    public:
+        /*
+        Read a log written by an emission_recorder of the same signal type.
+        Throw std::runtime_error if the header doesn't match the signal type.
+        */
+        static emission_log read(std::istream& in)
+        {
+            char magic[sizeof(detail::emission_log_magic)];
+            auto version = std::uint32_t{0};
+            auto signature_count = std::uint32_t{0};
+            const auto header_ok =
+                in.read(magic, sizeof(magic)) &&
+                std::memcmp(magic, detail::emission_log_magic, sizeof(magic)) == 0 &&
+                detail::read_value(in, version) &&
+                version == detail::emission_log_version &&
+                detail::read_value(in, signature_count) &&
+                signature_count == sizeof...(Signatures) &&
+                (read_payload_size<Signatures>(in) && ...)
+            ;
+            if(!header_ok)
+                throw std::runtime_error{"fgsig::emission_log: invalid header"};
+
+            auto log = emission_log{};
+            while(true)
+            {
+                auto r = record{};
+                auto timestamp = std::int64_t{0};
+                if(!detail::read_value(in, r.signature_index))
+                    break;
+                if
+                (
+                    r.signature_index >= sizeof...(Signatures) ||
+                    !detail::read_value(in, timestamp) ||
+                    !in.read(reinterpret_cast<char*>(r.payload.bytes), payload_sizes[r.signature_index])
+                )
+                {
+                    throw std::runtime_error{"fgsig::emission_log: invalid record"};
+                }
+                r.timestamp = std::chrono::nanoseconds{timestamp};
+                log.records_.push_back(r);
+            }
+            return log;
+        }
+
+        //Number of records
+        std::size_t size() const
+        {
+            return records_.size();
+        }
+
+        //Emit every record through the given signal.
+        void replay(signal_t& sig, const replay_speed speed = replay_speed::maximum) const
+        {
+            const auto start_time = std::chrono::steady_clock::now();
+            for(const auto& r: records_)
+            {
+                if(speed == replay_speed::recorded)
+                    std::this_thread::sleep_until(start_time + r.timestamp);
+
+                //Copy the payload, since slots are allowed to modify rvalue
+                //reference arguments.
+                auto payload = r.payload;
+                detail::trivial_codec_emit<Signatures...>(sig, r.signature_index, payload.bytes);
+            }
+        }
+
+    private:
+        template<typename Signature>
+        static bool read_payload_size(std::istream& in)
+        {
+            auto size = std::uint32_t{0};
+            return
+                detail::read_value(in, size) &&
+                size == detail::trivial_codec<Signature>::size
+            ;
+        }
+
+    private:
+        static constexpr std::size_t payload_sizes[] =
+        {
+            detail::trivial_codec<Signatures>::size...
+        };
+
+        std::vector<record> records_;
+};
+
+} //namespace
+
+#endif
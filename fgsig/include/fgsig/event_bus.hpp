@@ -0,0 +1,92 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_EVENT_BUS_HPP
+#define FGSIG_EVENT_BUS_HPP
+
+#include "signal.hpp"
+#include <utility>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    template<typename Event>
+    struct event_bus_leaf
+    {
+        signal<void(const Event&)> sig;
+    };
+}
+
+/*
+event_bus is a set of signals, one per event type, whose signatures are
+void(const Event&).
+It doesn't use a single signal<void(const Events&)...>, whose state would be
+allocated for all the event types as soon as one of them has a subscriber:
+here, an event type nobody subscribed to only costs the null state pointer
+of its signal.
+subscribe<Event>() only connects the given slot to the signal of the given event
+type, and publish() doesn't call any slot if nobody subscribed to the event
+type.
+Event types must be unique.
+*/
+template<typename... Events>
+struct event_bus:
+    private detail::event_bus_leaf<Events>...
+{
+    public:
+        event_bus() = default;
+
+        event_bus(const event_bus&) = delete;
+
+        event_bus(event_bus&&) = delete;
+
+        event_bus& operator=(const event_bus&) = delete;
+
+        event_bus& operator=(event_bus&&) = delete;
+
+        /*
+        Connect the given slot to the given event type.
+        Like connect(), return an owning_connection if the slot is an rvalue
+        reference, and a connection otherwise.
+        */
+        template<typename Event, typename Slot>
+        auto subscribe(Slot&& slot)
+        {
+            return connect(get_signal<Event>(), std::forward<Slot>(slot));
+        }
+
+        template<typename Event>
+        void publish(const Event& event)
+        {
+            get_signal<Event>().emit(event);
+        }
+
+        //Number of slots subscribed to the given event type
+        template<typename Event>
+        std::size_t subscriber_count() const
+        {
+            return get_signal<Event>().template slot_count<void(const Event&)>();
+        }
+
+    private:
+        template<typename Event>
+        signal<void(const Event&)>& get_signal()
+        {
+            return static_cast<detail::event_bus_leaf<Event>&>(*this).sig;
+        }
+
+        template<typename Event>
+        const signal<void(const Event&)>& get_signal() const
+        {
+            return static_cast<const detail::event_bus_leaf<Event>&>(*this).sig;
+        }
+};
+
+} //namespace
+
+#endif
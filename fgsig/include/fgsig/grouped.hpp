@@ -0,0 +1,70 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_GROUPED_HPP
+#define FGSIG_GROUPED_HPP
+
+#include "combined.hpp"
+#include "non_reentrant.hpp"
+#include <type_traits>
+
+namespace fgsig
+{
+
+/*
+grouped is a signal signature whose slots are called grouped by type rather
+than in connection order:
+    fgsig::signal<fgsig::grouped<void(int)>> sig;
+The slots of a given type are called in connection order, one after the other,
+so that emit() keeps calling the same function. This helps the branch predictor
+when many slots of a few types are connected. However, emit() then doesn't visit
+the closures in the order they've been allocated in, which can cost more than it
+saves when they don't fit in the L1 cache. Measure with the
+runtime_grouped_emission benchmark.
+Connecting and disconnecting a slot take constant time on average, whatever the
+number of slot types. The closures of the signature are one pointer larger
+though, since they keep the function of their group.
+A slot that is connected during an emission of the signature is called by this
+emission after the other slots, as with a non-grouped signature. It joins the
+slots of its type once the outermost emission returns.
+Signature can be a function type, a combined signature or a non_reentrant
+signature.
+*/
+template<typename Signature>
+struct grouped;
+
+namespace detail
+{
+    template<typename Signature>
+    struct function_signature<grouped<Signature>>
+    {
+        using type = function_signature_t<Signature>;
+    };
+
+    template<typename Signature>
+    struct is_grouped: std::false_type
+    {
+    };
+
+    template<typename Signature>
+    struct is_grouped<grouped<Signature>>: std::true_type
+    {
+    };
+
+    template<typename Signature>
+    struct is_grouped<non_reentrant<Signature>>: is_grouped<Signature>
+    {
+    };
+
+    template<typename Signature>
+    struct is_reentrant<grouped<Signature>>: is_reentrant<Signature>
+    {
+    };
+}
+
+} //namespace
+
+#endif
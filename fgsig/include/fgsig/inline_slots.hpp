@@ -0,0 +1,72 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_INLINE_SLOTS_HPP
+#define FGSIG_INLINE_SLOTS_HPP
+
+#include "combined.hpp"
+#include "grouped.hpp"
+#include "non_reentrant.hpp"
+#include "detail/raw_closure.hpp"
+#include <cstddef>
+#include <type_traits>
+
+namespace fgsig
+{
+
+/*
+inline_slots is a signal signature whose closures have room for a small slot:
+    fgsig::signal<fgsig::inline_slots<void(int)>> sig;
+An owning connection whose slot is trivially copyable, fits in four pointers
+and is only connected to this signature stores its slot in the closure, so
+that emit() finds the slot in the same list node as the function pointer.
+Every closure of the signature is larger, though, including the ones of
+non-owning connections. Only use it for signatures that mostly get small
+owned slots, such as lambdas that capture a few pointers.
+Signature can be a function type, a combined signature, a non_reentrant
+signature or a grouped signature.
+*/
+template<typename Signature>
+struct inline_slots;
+
+namespace detail
+{
+    template<typename Signature>
+    struct function_signature<inline_slots<Signature>>
+    {
+        using type = function_signature_t<Signature>;
+    };
+
+    template<typename Signature>
+    struct inline_slot_capacity<inline_slots<Signature>>
+    {
+        static constexpr std::size_t value = 4 * sizeof(void*);
+    };
+
+    template<typename Signature>
+    struct inline_slot_capacity<non_reentrant<Signature>>: inline_slot_capacity<Signature>
+    {
+    };
+
+    template<typename Signature>
+    struct inline_slot_capacity<grouped<Signature>>: inline_slot_capacity<Signature>
+    {
+    };
+
+    template<typename Signature>
+    struct is_reentrant<inline_slots<Signature>>: is_reentrant<Signature>
+    {
+    };
+
+    template<typename Signature>
+    struct is_grouped<inline_slots<Signature>>: is_grouped<Signature>
+    {
+    };
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,547 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_IPC_SIGNAL_HPP
+#define FGSIG_IPC_SIGNAL_HPP
+
+#ifndef __linux__
+#error "fgsig/ipc_signal.hpp is only available on Linux."
+#endif
+
+#include "signal.hpp"
+#include "tracing.hpp"
+#include "detail/trivial_codec.hpp"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    inline void futex_wait(std::atomic<std::uint32_t>& word, const std::uint32_t expected_value, const timespec* ptimeout)
+    {
+        static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+
+        //Not FUTEX_PRIVATE_FLAG, since the word is shared between processes.
+        syscall(SYS_futex, &word, FUTEX_WAIT, expected_value, ptimeout, nullptr, 0);
+    }
+
+    inline void futex_wake_all(std::atomic<std::uint32_t>& word)
+    {
+        syscall(SYS_futex, &word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    template<typename Derived, std::size_t Index, typename Signature>
+    struct ipc_signal_leaf;
+
+    template<typename Derived, std::size_t Index, typename... Args>
+    struct ipc_signal_leaf<Derived, Index, void(Args...)>
+    {
+        public:
+            void emit(Args... args)
+            {
+                static_cast<Derived&>(*this).write
+                (
+                    Index,
+                    [&args...](unsigned char* const buffer)
+                    {
+                        trivial_codec<void(Args...)>::write(buffer, args...);
+                    }
+                );
+            }
+    };
+
+    template<typename Derived, typename IndexSequence, typename... Signatures>
+    struct ipc_signal_base;
+
+    template<typename Derived, std::size_t... Indexes, typename... Signatures>
+    struct ipc_signal_base<Derived, std::index_sequence<Indexes...>, Signatures...>:
+        public ipc_signal_leaf<Derived, Indexes, Signatures>...
+    {
+        public:
+            using ipc_signal_leaf<Derived, Indexes, Signatures>::emit...;
+    };
+}
+
+/*
+basic_ipc_signal is a signal whose emit() function can be called from a process
+while the slots are called from other processes of the same machine.
+The object must live in memory that is shared between these processes, such as
+memory obtained with mmap(MAP_SHARED) before a fork(), or with
+ipc_shared_object.
+emit() stores the arguments in a ring buffer of Capacity records. Each
+subscribing process reads these records with an ipc_subscriber object, which
+emits them through a local signal.
+When the ring buffer is full, the oldest records are overwritten. The
+subscribers that haven't read them yet count them as lost.
+emit() can be called from several threads or processes at the same time. It
+doesn't wait for subscribers. It only waits for another emit() in the unlikely
+case where Capacity other emissions have been made while that emit() was still
+writing the record that has to be overwritten. If that emit() doesn't finish
+within a second (typically because its process has died while writing), the
+record is considered abandoned and taken over, and the late emit() drops its
+event if it ever resumes. A producer suspended for longer than that in the
+middle of emit() (e.g. by a debugger) can thus corrupt the record that has
+been taken over. Until then, subscribers stop at an abandoned record, and skip
+it once other emissions have overwritten it.
+The argument types must be trivially copyable (which excludes pointers to
+process-local memory from being useful).
+*/
+template<std::size_t Capacity, typename... Signatures>
+struct basic_ipc_signal:
+    public detail::ipc_signal_base
+    <
+        basic_ipc_signal<Capacity, Signatures...>,
+        std::index_sequence_for<Signatures...>,
+        Signatures...
+    >
+{
+    static_assert(Capacity > 0);
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+    private:
+        template<typename Derived, std::size_t Index, typename Signature>
+        friend struct detail::ipc_signal_leaf;
+
+        template<typename IpcSignal>
+        friend struct ipc_subscriber;
+
+        static constexpr auto payload_size = detail::max_size<detail::trivial_codec<Signatures>::size...>();
+        static constexpr auto payload_word_count = (payload_size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+        struct record
+        {
+            /*
+            For the lap n of the ring buffer (i.e. for ticket t, n = t / Capacity):
+            - 2n when the record is free to be written for lap n;
+            - 2n + 1 while a producer writes it;
+            - 2n + 2 once it's written (which also means free for lap n + 1).
+            */
+            std::atomic<std::uint64_t> stamp{0};
+
+            std::atomic<std::uint32_t> signature_index{0};
+
+            //The payload is stored in atomic words so that reading a record
+            //while it's being overwritten isn't a data race. Such a read is
+            //detected thanks to the stamp.
+            std::atomic<std::uint64_t> payload[payload_word_count > 0 ? payload_word_count : 1]{};
+        };
+
+        //Process-local copy of a payload
+        struct payload_buffer
+        {
+            alignas(std::max_align_t) std::uint64_t words[payload_word_count + 1];
+        };
+
+    public:
+        basic_ipc_signal() = default;
+
+        basic_ipc_signal(const basic_ipc_signal&) = delete;
+
+        basic_ipc_signal(basic_ipc_signal&&) = delete;
+
+        basic_ipc_signal& operator=(const basic_ipc_signal&) = delete;
+
+        basic_ipc_signal& operator=(basic_ipc_signal&&) = delete;
+
+        static constexpr std::size_t capacity()
+        {
+            return Capacity;
+        }
+
+    private:
+        template<typename WriteFn>
+        void write(const std::size_t signature_index, WriteFn&& write_payload)
+        {
+            auto buffer = payload_buffer{};
+            write_payload(reinterpret_cast<unsigned char*>(buffer.words));
+
+            const auto ticket = write_ticket_.fetch_add(1, std::memory_order_relaxed);
+            auto& r = records_[ticket % Capacity];
+            const auto free_stamp = 2 * (ticket / Capacity);
+
+            //Claim the record. If the producer of the previous lap is still
+            //writing it, wait until it's done rather than mixing our payload
+            //with its own. If it doesn't finish in time, it has presumably
+            //died after claiming the record, and we take the record over.
+            auto expected_stamp = free_stamp;
+            auto wait_start = std::chrono::steady_clock::time_point{};
+            while(!r.stamp.compare_exchange_weak(expected_stamp, free_stamp + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                //A producer of a later lap has taken the record over from us.
+                if(expected_stamp > free_stamp)
+                    return;
+
+                const auto now = std::chrono::steady_clock::now();
+                if(wait_start == std::chrono::steady_clock::time_point{})
+                    wait_start = now;
+
+                if(now - wait_start < abandoned_record_timeout)
+                {
+                    expected_stamp = free_stamp;
+                    std::this_thread::yield();
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+
+            r.signature_index.store(static_cast<std::uint32_t>(signature_index), std::memory_order_relaxed);
+            for(std::size_t i = 0; i < payload_word_count; ++i)
+                r.payload[i].store(buffer.words[i], std::memory_order_relaxed);
+
+            //This fails if a producer of a later lap has taken the record over.
+            auto claimed_stamp = free_stamp + 1;
+            if(!r.stamp.compare_exchange_strong(claimed_stamp, free_stamp + 2, std::memory_order_release, std::memory_order_relaxed))
+                return;
+
+            //Wake up the subscribers that wait for a record.
+            notification_count_.fetch_add(1);
+            if(waiter_count_.load() != 0)
+                detail::futex_wake_all(notification_count_);
+        }
+
+    private:
+        static constexpr auto abandoned_record_timeout = std::chrono::seconds{1};
+
+    private:
+        alignas(64) std::atomic<std::uint64_t> write_ticket_{0};
+        alignas(64) std::atomic<std::uint32_t> notification_count_{0};
+        std::atomic<std::uint32_t> waiter_count_{0};
+        alignas(64) record records_[Capacity];
+};
+
+template<typename... Signatures>
+using ipc_signal = basic_ipc_signal<256, Signatures...>;
+
+/*
+ipc_subscriber reads the records written in the given ipc signal and emits
+them through the given local signal, whose slots are thus called from the
+process (and the thread) that calls the drain functions.
+It only reads the records written after its construction.
+*/
+template<typename IpcSignal>
+struct ipc_subscriber;
+
+template<std::size_t Capacity, typename... Signatures>
+struct ipc_subscriber<basic_ipc_signal<Capacity, Signatures...>>
+{
+    private:
+        using ipc_signal_t = basic_ipc_signal<Capacity, Signatures...>;
+        using local_signal_t = signal<Signatures...>;
+
+    public:
+        ipc_subscriber(ipc_signal_t& ipc_sig, local_signal_t& local_sig):
+            pipc_signal_(&ipc_sig),
+            plocal_signal_(&local_sig),
+            read_ticket_(ipc_sig.write_ticket_.load(std::memory_order_acquire))
+        {
+        }
+
+        /*
+        Emit the available records through the local signal.
+        Return the number of emitted records.
+        */
+        std::size_t drain()
+        {
+            auto count = std::size_t{0};
+
+            //Skip the records that have been overwritten.
+            const auto write_ticket = pipc_signal_->write_ticket_.load(std::memory_order_acquire);
+            if(write_ticket - read_ticket_ > Capacity)
+            {
+                lost_count_ += write_ticket - Capacity - read_ticket_;
+                read_ticket_ = write_ticket - Capacity;
+            }
+
+            while(true)
+            {
+                auto& r = pipc_signal_->records_[read_ticket_ % Capacity];
+                const auto expected_stamp = 2 * (read_ticket_ / Capacity) + 2;
+
+                //Only accept the stamp of the lap of read_ticket_.
+                const auto stamp = r.stamp.load(std::memory_order_acquire);
+                if(stamp < expected_stamp)
+                {
+                    //Not written yet
+                    break;
+                }
+
+                if(stamp == expected_stamp)
+                {
+                    auto buffer = typename ipc_signal_t::payload_buffer{};
+                    const auto signature_index = r.signature_index.load(std::memory_order_relaxed);
+                    for(std::size_t i = 0; i < ipc_signal_t::payload_word_count; ++i)
+                        buffer.words[i] = r.payload[i].load(std::memory_order_relaxed);
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if(r.stamp.load(std::memory_order_relaxed) == stamp)
+                    {
+                        ++read_ticket_;
+                        ++count;
+                        detail::trivial_codec_emit<Signatures...>(*plocal_signal_, signature_index, reinterpret_cast<unsigned char*>(buffer.words));
+                        continue;
+                    }
+                }
+
+                //Overwritten before or while we were reading it
+                ++read_ticket_;
+                ++lost_count_;
+            }
+
+            return count;
+        }
+
+        /*
+        Wait until at least one record is available (or until the given
+        timeout expires), then emit the available records through the local
+        signal.
+        Return the number of emitted records.
+        */
+        std::size_t wait_and_drain()
+        {
+            return wait_and_drain_impl(nullptr);
+        }
+
+        std::size_t wait_and_drain(const std::chrono::nanoseconds timeout)
+        {
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            const auto ts = timespec
+            {
+                static_cast<time_t>(seconds.count()),
+                static_cast<long>((timeout - seconds).count())
+            };
+            return wait_and_drain_impl(&ts);
+        }
+
+        //Number of records that have been overwritten before being read
+        std::size_t lost_count() const
+        {
+            return lost_count_;
+        }
+
+    private:
+        std::size_t wait_and_drain_impl(const timespec* const ptimeout)
+        {
+            auto& notification_count = pipc_signal_->notification_count_;
+            const auto observed_notification_count = notification_count.load();
+
+            if(const auto count = drain())
+                return count;
+
+            //If a record is written after the load of notification_count,
+            //futex_wait() returns immediately.
+            ++pipc_signal_->waiter_count_;
+            detail::futex_wait(notification_count, observed_notification_count, ptimeout);
+            --pipc_signal_->waiter_count_;
+
+            return drain();
+        }
+
+
+    private:
+        ipc_signal_t* pipc_signal_;
+        local_signal_t* plocal_signal_;
+        std::uint64_t read_ticket_;
+        std::size_t lost_count_ = 0;
+};
+
+template<std::size_t Capacity, typename... Signatures>
+ipc_subscriber(basic_ipc_signal<Capacity, Signatures...>&, signal<Signatures...>&) ->
+    ipc_subscriber<basic_ipc_signal<Capacity, Signatures...>>;
+
+/*
+ipc_shared_object maps an object of type T that lives in POSIX shared memory.
+create() creates the shared memory object of the given name and constructs the
+T object in it. open() maps an existing one. remove() removes the name.
+The T object is stored after a tag that identifies its type (from its name, as
+given by the compiler, and its size). The tag is written once the object is
+constructed, so that open() can reject a shared memory object that is still
+being created (with std::errc::resource_unavailable_try_again) or that has been
+created for another type (with std::errc::invalid_argument), instead of
+crashing on the first access.
+The T object is never destroyed, so it must be trivially destructible or be
+fine with not being destroyed (such as basic_ipc_signal).
+Functions throw std::system_error on failure.
+*/
+template<typename T>
+struct ipc_shared_object
+{
+    private:
+        struct shared_block
+        {
+            std::atomic<std::uint64_t> tag;
+            T object;
+        };
+
+    public:
+        static ipc_shared_object create(const char* const name)
+        {
+            const auto fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+            if(fd == -1)
+                throw_system_error("shm_open");
+
+            auto guard = fd_guard{fd, name};
+
+            if(ftruncate(fd, sizeof(shared_block)) == -1)
+                throw_system_error("ftruncate");
+
+            auto obj = ipc_shared_object{map(fd)};
+            new(obj.pblock_) shared_block{};
+            obj.pblock_->tag.store(layout_tag(), std::memory_order_release);
+
+            guard.pname_to_unlink = nullptr;
+            return obj;
+        }
+
+        static ipc_shared_object open(const char* const name)
+        {
+            const auto fd = shm_open(name, O_RDWR, 0600);
+            if(fd == -1)
+                throw_system_error("shm_open");
+
+            const auto guard = fd_guard{fd, nullptr};
+
+            //Mapping more than the size of the shared memory object would
+            //raise SIGBUS on access.
+            struct stat st;
+            if(fstat(fd, &st) == -1)
+                throw_system_error("fstat");
+            if(st.st_size == 0)
+                throw_error(std::errc::resource_unavailable_try_again, "ipc_shared_object: object being created");
+            if(static_cast<std::size_t>(st.st_size) != sizeof(shared_block))
+                throw_error(std::errc::invalid_argument, "ipc_shared_object: size mismatch");
+
+            auto obj = ipc_shared_object{map(fd)};
+
+            const auto tag = std::launder(obj.pblock_)->tag.load(std::memory_order_acquire);
+            if(tag == 0)
+                throw_error(std::errc::resource_unavailable_try_again, "ipc_shared_object: object being created");
+            if(tag != layout_tag())
+                throw_error(std::errc::invalid_argument, "ipc_shared_object: type mismatch");
+
+            return obj;
+        }
+
+        static void remove(const char* const name)
+        {
+            if(shm_unlink(name) == -1)
+                throw_system_error("shm_unlink");
+        }
+
+        ipc_shared_object(const ipc_shared_object&) = delete;
+
+        ipc_shared_object(ipc_shared_object&& r):
+            pblock_(r.pblock_)
+        {
+            r.pblock_ = nullptr;
+        }
+
+        ipc_shared_object& operator=(const ipc_shared_object&) = delete;
+
+        ipc_shared_object& operator=(ipc_shared_object&&) = delete;
+
+        ~ipc_shared_object()
+        {
+            if(pblock_)
+                munmap(pblock_, sizeof(shared_block));
+        }
+
+        T& get()
+        {
+            return std::launder(pblock_)->object;
+        }
+
+    private:
+        //Closes the given file descriptor and, if pname_to_unlink isn't
+        //null, removes the given name (i.e. the creation has failed).
+        struct fd_guard
+        {
+            fd_guard(const int fd, const char* const pname_to_unlink):
+                fd(fd),
+                pname_to_unlink(pname_to_unlink)
+            {
+            }
+
+            fd_guard(const fd_guard&) = delete;
+
+            fd_guard& operator=(const fd_guard&) = delete;
+
+            ~fd_guard()
+            {
+                close(fd);
+                if(pname_to_unlink)
+                    shm_unlink(pname_to_unlink);
+            }
+
+            int fd;
+            const char* pname_to_unlink;
+        };
+
+        explicit ipc_shared_object(shared_block* const pblock):
+            pblock_(pblock)
+        {
+        }
+
+        //FNV-1a hash of the name and size of T, which is never 0 in practice
+        static std::uint64_t layout_tag()
+        {
+            auto hash = std::uint64_t{14695981039346656037u};
+            const auto mix = [&hash](const unsigned char c)
+            {
+                hash ^= c;
+                hash *= 1099511628211u;
+            };
+
+            for(auto pname = detail::type_name<T>(); *pname != '\0'; ++pname)
+                mix(static_cast<unsigned char>(*pname));
+            for(auto size = sizeof(T); size != 0; size >>= 8)
+                mix(static_cast<unsigned char>(size & 0xff));
+
+            return hash != 0 ? hash : 1;
+        }
+
+        static shared_block* map(const int fd)
+        {
+            const auto p = mmap(nullptr, sizeof(shared_block), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(p == MAP_FAILED)
+                throw_system_error("mmap");
+            return static_cast<shared_block*>(p);
+        }
+
+        [[noreturn]] static void throw_system_error(const char* const what)
+        {
+            throw std::system_error{errno, std::generic_category(), what};
+        }
+
+        [[noreturn]] static void throw_error(const std::errc error, const char* const what)
+        {
+            throw std::system_error{std::make_error_code(error), what};
+        }
+
+    private:
+        shared_block* pblock_;
+};
+
+} //namespace
+
+#endif
@@ -0,0 +1,111 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_METHOD_SLOT_HPP
+#define FGSIG_METHOD_SLOT_HPP
+
+#include "connection.hpp"
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    /*
+    method_slot is the slot type of a connection to the given member functions
+    of an object of type T.
+    It's never instantiated: the raw closures directly point to the object.
+    */
+    template<typename T, auto... Methods>
+    struct method_slot;
+
+    template<typename T, auto... Methods>
+    struct slot_object<method_slot<T, Methods...>>
+    {
+        using type = T;
+    };
+
+    //Index of the first method of Methods that can be called with Args and
+    //whose return type converts to R
+    template<typename T, typename ArgList, auto... Methods>
+    struct method_index;
+
+    template<typename T, typename R, typename... Args, auto... Methods>
+    struct method_index<T, R(Args...), Methods...>
+    {
+        static constexpr std::size_t get()
+        {
+            constexpr bool invocables[] =
+            {
+                std::is_invocable_r_v<R, decltype(Methods), T&, Args...>...
+            };
+
+            for(std::size_t i = 0; i < sizeof...(Methods); ++i)
+                if(invocables[i])
+                    return i;
+
+            return sizeof...(Methods);
+        }
+
+        static constexpr auto value = get();
+    };
+
+    template<typename T, auto... Methods, typename R, typename... Args>
+    struct slot_caller<method_slot<T, Methods...>, R(Args...)>
+    {
+        private:
+            static constexpr auto method_index_value = method_index<T, R(Args...), Methods...>::value;
+
+            static_assert
+            (
+                method_index_value < sizeof...(Methods),
+                "None of the given methods can be called with the arguments of the signature."
+            );
+
+            static constexpr auto method = std::get<method_index_value>(std::make_tuple(Methods...));
+
+        public:
+            static R call(void* pvobj, Args... args)
+            {
+#ifdef FGSIG_ENABLE_TRACING
+                const auto trace = slot_call_trace<method_slot<T, Methods...>>{};
+#endif
+                auto& obj = *reinterpret_cast<T*>(pvobj);
+                return (obj.*method)(std::forward<Args>(args)...);
+            }
+    };
+
+    template<typename T, auto... Methods, typename R, typename... Args>
+    struct is_slot_invocable<method_slot<T, Methods...>, R(Args...)>:
+        std::bool_constant<method_index<T, R(Args...), Methods...>::value < sizeof...(Methods)>
+    {
+    };
+}
+
+/*
+Return the given member function pointer.
+Use it to select an overload of a member function:
+    fgsig::overload<const event&>(&receiver::on_event)
+*/
+template<typename... Args, typename T, typename R>
+constexpr auto overload(R(T::*pmethod)(Args...))
+{
+    return pmethod;
+}
+
+template<typename... Args, typename T, typename R>
+constexpr auto overload(R(T::*pmethod)(Args...) const)
+{
+    return pmethod;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,50 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_NON_REENTRANT_HPP
+#define FGSIG_NON_REENTRANT_HPP
+
+#include "combined.hpp"
+#include <type_traits>
+
+namespace fgsig
+{
+
+/*
+non_reentrant is a signal signature whose slots never close a connection nor
+emit the same signature again:
+    fgsig::signal<fgsig::non_reentrant<void(int)>> sig;
+    sig.emit(0);
+Signature can be a function type or a combined signature.
+Since emit() doesn't have to handle these cases, it only calls the slots.
+Breaking the rule is undefined behavior. Debug builds (without NDEBUG) check it
+with assert().
+*/
+template<typename Signature>
+struct non_reentrant;
+
+namespace detail
+{
+    template<typename Signature>
+    struct function_signature<non_reentrant<Signature>>
+    {
+        using type = function_signature_t<Signature>;
+    };
+
+    template<typename Signature>
+    struct is_reentrant: std::true_type
+    {
+    };
+
+    template<typename Signature>
+    struct is_reentrant<non_reentrant<Signature>>: std::false_type
+    {
+    };
+}
+
+} //namespace
+
+#endif
@@ -13,11 +13,39 @@
 namespace fgsig
 {
 
+namespace detail
+{
+    /*
+    Whether owning_connection stores the slot in the closure of the signal,
+    which is the case for small slots connected to a single signature
+    */
+    template<typename Slot, typename SignatureList>
+    struct is_inline_owned_slot
+    {
+        static constexpr bool value = false;
+    };
+
+    template<typename Slot, typename Signature>
+    struct is_inline_owned_slot<Slot, signature_list<Signature>>
+    {
+        static constexpr bool value = is_inline_slot<Slot, Signature>::value;
+    };
+}
+
 /*
 owning_connection is a connection that owns the slot it connects to the signal.
 */
-template<typename Signal, typename Slot>
-struct owning_connection
+template
+<
+    typename Signal,
+    typename Slot,
+    typename SignatureList = detail::signal_signature_list_t<Signal>,
+    bool InlineSlot = detail::is_inline_owned_slot<Slot, SignatureList>::value
+>
+struct owning_connection;
+
+template<typename Signal, typename Slot, typename SignatureList>
+struct owning_connection<Signal, Slot, SignatureList, false>
 {
     public:
         owning_connection(Signal& sig, Slot&& slot):
@@ -30,15 +58,14 @@ struct owning_connection
 
         /*
         Move constructor:
-        - Move slot
-        - Connect signal to new slot
-        - Disconnect signal from moved-from slot
+        Move the slot, and make the closures of r call the new slot. The slot
+        keeps its position in the call order, and nothing is allocated.
         */
         owning_connection(owning_connection&& r):
             slot_(std::move(r.slot_)),
-            connection_(*r.connection_.psignal_, slot_)
+            connection_(std::move(r.connection_))
         {
-            r.connection_.close();
+            connection_.repoint(slot_);
         }
 
         void close()
@@ -46,9 +73,66 @@ struct owning_connection
             connection_.close();
         }
 
+        void block()
+        {
+            connection_.block();
+        }
+
+        void unblock()
+        {
+            connection_.unblock();
+        }
+
+        bool blocked() const
+        {
+            return connection_.blocked();
+        }
+
     private:
         Slot slot_;
-        connection<Signal, Slot> connection_;
+        connection<Signal, Slot, SignatureList> connection_;
+};
+
+/*
+Specialization for small slots connected to a single signature
+The slot is stored in the closure of the signal, so that emit() finds it next
+to the function pointer. The slot doesn't move when the connection is moved.
+*/
+template<typename Signal, typename Slot, typename SignatureList>
+struct owning_connection<Signal, Slot, SignatureList, true>
+{
+    public:
+        owning_connection(Signal& sig, Slot&& slot):
+            connection_(sig, slot, detail::inline_slot_tag{})
+        {
+        }
+
+        owning_connection(const owning_connection&) = delete;
+
+        owning_connection(owning_connection&&) = default;
+
+        void close()
+        {
+            connection_.close();
+        }
+
+        void block()
+        {
+            connection_.block();
+        }
+
+        void unblock()
+        {
+            connection_.unblock();
+        }
+
+        bool blocked() const
+        {
+            return connection_.blocked();
+        }
+
+    private:
+        connection<Signal, Slot, SignatureList> connection_;
 };
 
 } //namespace
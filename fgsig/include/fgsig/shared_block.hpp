@@ -0,0 +1,49 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_SHARED_BLOCK_HPP
+#define FGSIG_SHARED_BLOCK_HPP
+
+namespace fgsig
+{
+
+/*
+shared_block blocks the given connection for the lifetime of the shared_block
+object.
+Several shared_block objects can block the same connection: the connection is
+unblocked when the last one is destroyed.
+Connection can be any connection, owning_connection or any_connection type.
+*/
+template<typename Connection>
+struct shared_block
+{
+    public:
+        shared_block(Connection& c):
+            connection_(c)
+        {
+            connection_.block();
+        }
+
+        shared_block(const shared_block&) = delete;
+
+        shared_block(shared_block&&) = delete;
+
+        shared_block& operator=(const shared_block&) = delete;
+
+        shared_block& operator=(shared_block&&) = delete;
+
+        ~shared_block()
+        {
+            connection_.unblock();
+        }
+
+    private:
+        Connection& connection_;
+};
+
+} //namespace
+
+#endif
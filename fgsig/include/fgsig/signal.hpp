@@ -9,12 +9,30 @@
 
 #include "owning_connection.hpp"
 #include "connection.hpp"
+#include "connection_set.hpp"
+#include "method_slot.hpp"
+#include "trackable.hpp"
+#include "combined.hpp"
+#include "combiners.hpp"
+#include "grouped.hpp"
+#include "inline_slots.hpp"
+#include "non_reentrant.hpp"
 #include "detail/raw_closure.hpp"
 #include "detail/voidp_function_ptr.hpp"
+#ifdef FGSIG_ENABLE_TRACING
+#include "tracing.hpp"
+#endif
+#include <cassert>
 #include <list>
+#include <memory>
+#include <new>
 #include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace fgsig
 {
@@ -22,122 +40,980 @@ namespace fgsig
 namespace detail
 {
     /*
-    Base types for signal
-    We have to use inheritance to let the compiler do the overload resolution
-    for the emit() member function.
+    Function of the closures that emit() must skip, i.e. the blocked ones and
+    the ones whose erasure has been postponed
+    For void signatures, it's a function that does nothing, so that emit()
+    doesn't have to check whether a closure must be skipped.
     */
+    template<typename Signature>
+    struct skipped_closure_function
+    {
+        static constexpr voidp_function_ptr<Signature> value = nullptr;
+    };
 
-    template<typename... Signatures>
-    struct signal_base;
+    template<typename... Args>
+    struct skipped_closure_function<void(Args...)>
+    {
+        static void noop(void*, Args...)
+        {
+        }
+
+        static constexpr voidp_function_ptr<void(Args...)> value = &noop;
+    };
 
-    template<typename Signature, typename... Signatures>
-    struct signal_base<Signature, Signatures...>:
-        public signal_base<Signature>,
-        public signal_base<Signatures...>
+    /*
+    closure_groups keeps track of the position of the closures of each function
+    in the closure list of a grouped signature, so that a new closure can be
+    inserted after the last closure of the same function.
+    The closures of a group stay contiguous even when they're blocked or
+    marked as removed. Only release_closure() takes them out.
+    Closures that are added during an emission are appended to the list, like
+    for non-grouped signatures, so that the emission calls them whatever their
+    function. They join their group when the outermost emission ends, through
+    insert_deferred().
+    Groups are stored in a hash table indexed by function, and each closure
+    keeps the function of its group (in group_pf), so that every operation
+    takes constant time on average. reserve() sizes the table, so that it
+    doesn't grow while there are no more groups than reserved closures.
+    */
+    template<typename Signature, bool Grouped = is_grouped<Signature>::value>
+    struct closure_groups
     {
         public:
-            using signal_base<Signature>::emit;
-            using signal_base<Signatures...>::emit;
+            using iterator = typename raw_closure_list<Signature>::iterator;
+
+            //Position where a closure of the given function must be inserted
+            iterator insert_position(const voidp_function_ptr<Signature> pf, const iterator end) const
+            {
+                const auto index = find(pf);
+                return index != npos ? std::next(groups_[index].last) : end;
+            }
+
+            void on_insert(const voidp_function_ptr<Signature> pf, const iterator it)
+            {
+                it->group_pf = pf;
+
+                const auto index = find(pf);
+                if(index != npos)
+                    groups_[index].last = it;
+                else
+                    add(group{pf, it, it});
+            }
+
+            //Must be called before the closure leaves the list.
+            void on_release(const iterator it)
+            {
+                //The closure may not belong to any group (e.g. if it's been
+                //marked as removed before joining its group).
+                const auto index = find(it->group_pf);
+                if(index == npos)
+                    return;
+
+                auto& g = groups_[index];
+                if(g.first == it)
+                {
+                    if(g.last == it)
+                        erase(index);
+                    else
+                        g.first = std::next(it);
+                }
+                else if(g.last == it)
+                {
+                    g.last = std::prev(it);
+                }
+            }
+
+            //Record a closure that has been appended during an emission.
+            void on_deferred_insert(const voidp_function_ptr<Signature> pf, const iterator it)
+            {
+                it->group_pf = pf;
+                deferred_inserts_.push_back(it);
+            }
+
+            /*
+            Move the closures appended during the emission to their group.
+            Must be called before the closures that have been marked as removed
+            are released, which are left at the end of the list.
+            */
+            void insert_deferred(raw_closure_list<Signature>& closures)
+            {
+                for(const auto it: deferred_inserts_)
+                {
+                    if(it->pvslot == nullptr)
+                        continue;
+
+                    const auto pos = insert_position(it->group_pf, closures.end());
+                    if(pos != it)
+                        closures.splice(pos, closures, it);
+                    on_insert(it->group_pf, it);
+                }
+                deferred_inserts_.clear();
+            }
+
+            //Preallocate enough memory for n groups and n deferred insertions.
+            void reserve(const std::size_t n)
+            {
+                if(2 * n > groups_.size())
+                    rehash(2 * n);
+                deferred_inserts_.reserve(n);
+            }
+
+            void clear()
+            {
+                for(auto& g: groups_)
+                    g.pf = nullptr;
+                group_count_ = 0;
+                deferred_inserts_.clear();
+            }
+
+            std::size_t memory_usage() const
+            {
+                return
+                    groups_.capacity() * sizeof(group) +
+                    deferred_inserts_.capacity() * sizeof(iterator)
+                ;
+            }
+
+        private:
+            struct group
+            {
+                //Null for the unused entries of the table
+                voidp_function_ptr<Signature> pf;
+
+                iterator first;
+                iterator last;
+            };
+
+            static constexpr auto npos = static_cast<std::size_t>(-1);
+
+            std::size_t home_index(const voidp_function_ptr<Signature> pf) const
+            {
+                //Fibonacci hashing, since functions are aligned
+                const auto hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pf)) * 0x9e3779b97f4a7c15u;
+                return static_cast<std::size_t>(hash >> 32) & (groups_.size() - 1);
+            }
+
+            std::size_t next_index(const std::size_t index) const
+            {
+                return (index + 1) & (groups_.size() - 1);
+            }
+
+            //Index of the group of the given function, or npos
+            std::size_t find(const voidp_function_ptr<Signature> pf) const
+            {
+                if(group_count_ == 0)
+                    return npos;
+
+                for(auto i = home_index(pf); groups_[i].pf; i = next_index(i))
+                    if(groups_[i].pf == pf)
+                        return i;
+
+                return npos;
+            }
 
-            using signal_base<Signature>::add_raw_event_closure;
-            using signal_base<Signatures...>::add_raw_event_closure;
+            void add(const group& g)
+            {
+                //Keep the table at most half full.
+                if(2 * (group_count_ + 1) > groups_.size())
+                    rehash(2 * (group_count_ + 1));
+
+                auto i = home_index(g.pf);
+                while(groups_[i].pf)
+                    i = next_index(i);
+                groups_[i] = g;
+                ++group_count_;
+            }
+
+            void erase(std::size_t index)
+            {
+                groups_[index].pf = nullptr;
+                --group_count_;
+
+                //Move back the next groups of the probe sequence that can't be
+                //reached anymore.
+                const auto mask = groups_.size() - 1;
+                for(auto i = next_index(index); groups_[i].pf; i = next_index(i))
+                {
+                    const auto home = home_index(groups_[i].pf);
+                    if(((i - home) & mask) >= ((i - index) & mask))
+                    {
+                        groups_[index] = groups_[i];
+                        groups_[i].pf = nullptr;
+                        index = i;
+                    }
+                }
+            }
+
+            //Resize the table to the power of two that is at least the given
+            //size (and at least 8).
+            void rehash(const std::size_t min_size)
+            {
+                auto size = std::size_t{8};
+                while(size < min_size)
+                    size *= 2;
+
+                auto old_groups = std::vector<group>(size);
+                old_groups.swap(groups_);
+                group_count_ = 0;
+                for(const auto& g: old_groups)
+                    if(g.pf)
+                        add(g);
+            }
+
+        private:
+            //Hash table of the groups, with linear probing. Its size is zero
+            //or a power of two.
+            std::vector<group> groups_;
+            std::size_t group_count_ = 0;
 
-            using signal_base<Signature>::remove_raw_event_closure;
-            using signal_base<Signatures...>::remove_raw_event_closure;
+            //Closures appended during the current emission
+            std::vector<iterator> deferred_inserts_;
     };
 
-    //leaf specialization
-    template<typename R, typename... Args>
-    struct signal_base<R(Args...)>
+    //Non-grouped signatures always append closures.
+    template<typename Signature>
+    struct closure_groups<Signature, false>
     {
-        static_assert(std::is_same_v<R, void>, "The return type of a signal signature must be void.");
+        public:
+            using iterator = typename raw_closure_list<Signature>::iterator;
 
-        private:
-            using signature = void(Args...);
+            static iterator insert_position(voidp_function_ptr<Signature>, const iterator end)
+            {
+                return end;
+            }
+
+            static void on_insert(voidp_function_ptr<Signature>, iterator)
+            {
+            }
+
+            static void on_deferred_insert(voidp_function_ptr<Signature>, iterator)
+            {
+            }
+
+            static void insert_deferred(raw_closure_list<Signature>&)
+            {
+            }
+
+            static void on_release(iterator)
+            {
+            }
 
+            static void reserve(std::size_t)
+            {
+            }
+
+            static void clear()
+            {
+            }
+
+            static std::size_t memory_usage()
+            {
+                return 0;
+            }
+    };
+
+    /*
+    signal_leaf_base holds the closures of a single signature.
+    */
+    template<typename Signature>
+    struct signal_leaf_base
+    {
         public:
-            void emit(Args... args)
+            raw_closure_id<Signature> add_raw_event_closure(const voidp_function_ptr<Signature> pf, void* pvslot)
             {
-                //Call slots.
+                //Don't insert in the middle of the list while we're iterating
+                //on it. See closure_groups.
+                const auto emitting = recursivity_level_ != 0;
+                const auto pos = emitting ? closures_.end() : groups_.insert_position(pf, closures_.end());
+
+                auto it = pos;
+                if(spare_closures_.empty())
                 {
-                    struct recursivity_level_incrementer
+                    it = closures_.emplace(pos, pf, pvslot);
+                }
+                else
+                {
+                    //Reuse a reserved node.
+                    it = spare_closures_.begin();
+                    closures_.splice(pos, spare_closures_, it);
+                    it->pf = pf;
+                    it->pvslot = pvslot;
+                }
+
+                if(emitting)
+                    groups_.on_deferred_insert(pf, it);
+                else
+                    groups_.on_insert(pf, it);
+
+                ++live_closure_count_;
+
+                return raw_closure_id<Signature>{it, generation_};
+            }
+
+            //Add a closure that stores a copy of the given slot.
+            template<typename Slot>
+            raw_closure_id<Signature> add_raw_event_closure_with_inline_slot(const voidp_function_ptr<Signature> pf, const Slot& slot)
+            {
+                static_assert(is_inline_slot<Slot, Signature>::value);
+
+                const auto id = add_raw_event_closure(pf, nullptr);
+                id.it->pvslot = new(id.it->slot_storage) Slot(slot);
+                return id;
+            }
+
+            //Do nothing if the closure has been removed by disconnect_all().
+            void remove_raw_event_closure(const raw_closure_id<Signature> id)
+            {
+                if(id.generation != generation_)
+                    return;
+
+                if constexpr(!reentrant)
+                {
+                    assert(recursivity_level_ == 0 && "A connection of a non_reentrant signature has been closed during emission.");
+                    release_closure(id.it);
+                }
+                else if(recursivity_level_ == 0) //Are we iterating on closures_?
+                {
+                    //If not, erase right now.
+                    release_closure(id.it);
+                }
+                else
+                {
+                    //If so, postpone erasing.
+                    mark_closure_as_removed(*id.it);
+                }
+            }
+
+            //Make emit() skip the given closure.
+            void block_raw_event_closure(const raw_closure_id<Signature> id)
+            {
+                if(id.generation == generation_ && id.it->pf != skipped_closure_pf)
+                {
+                    id.it->pf = skipped_closure_pf;
+                    --live_closure_count_;
+                }
+            }
+
+            //Make emit() call the given function again.
+            void unblock_raw_event_closure(const raw_closure_id<Signature> id, const voidp_function_ptr<Signature> pf)
+            {
+                if(id.generation == generation_ && id.it->pf == skipped_closure_pf)
+                {
+                    id.it->pf = pf;
+                    ++live_closure_count_;
+                }
+            }
+
+            //Make the given closure call its function with the given slot.
+            void repoint_raw_event_closure(const raw_closure_id<Signature> id, void* pvslot)
+            {
+                //Leave removed closures as they are.
+                if(id.generation == generation_ && id.it->pvslot != nullptr)
+                    id.it->pvslot = pvslot;
+            }
+
+            /*
+            Remove all the closures in one pass.
+            The IDs of the removed closures become stale, so that removing them
+            later is a no-op.
+            */
+            void disconnect_all()
+            {
+                ++generation_;
+                groups_.clear();
+
+                assert((reentrant || recursivity_level_ == 0) && "A non_reentrant signature has been disconnected during emission.");
+
+                if(recursivity_level_ == 0)
+                {
+                    //Keep the nodes we need to honor the reserved capacity.
+                    spare_closures_.splice(spare_closures_.begin(), closures_);
+                    while(spare_closures_.size() > capacity_)
+                        spare_closures_.pop_back();
+                    live_closure_count_ = 0;
+                }
+                else
+                {
+                    for(auto& c: closures_)
+                        if(c.pvslot != nullptr)
+                            mark_closure_as_removed(c);
+                }
+            }
+
+            /*
+            Move all the closures to the given list, and make their IDs stale.
+            Unlike with disconnect_all(), the closures are still reachable
+            through the list.
+            Can't be called during an emission.
+            */
+            void detach_all(raw_closure_list<Signature>& detached_closures)
+            {
+                assert(recursivity_level_ == 0);
+
+                ++generation_;
+                groups_.clear();
+                live_closure_count_ = 0;
+                detached_closures.splice(detached_closures.end(), closures_);
+            }
+
+            //Number of connected slots
+            std::size_t slot_count() const
+            {
+                return closures_.size() - removed_closure_count_;
+            }
+
+            //Whether emit() would call at least one slot, i.e. whether a
+            //closure is neither blocked nor marked as removed
+            bool has_live_closure() const
+            {
+                return live_closure_count_ != 0;
+            }
+
+            //Preallocate enough nodes to hold n closures.
+            void reserve(const std::size_t n)
+            {
+                if(capacity_ < n)
+                    capacity_ = n;
+
+                while(closures_.size() + spare_closures_.size() < capacity_)
+                    spare_closures_.emplace_back(skipped_closure_pf, nullptr);
+
+                groups_.reserve(n);
+            }
+
+            //Free the preallocated nodes.
+            void shrink_to_fit()
+            {
+                capacity_ = 0;
+                spare_closures_.clear();
+            }
+
+            //Number of emissions in progress, only tracked if
+            //tracks_recursivity_level is true
+            unsigned int recursivity_level() const
+            {
+                return recursivity_level_;
+            }
+
+            //Whether the leaf holds no node and isn't emitting
+            bool unused() const
+            {
+                return closures_.empty() && spare_closures_.empty() && recursivity_level_ == 0;
+            }
+
+            //Size of dynamically allocated memory, in bytes
+            std::size_t memory_usage() const
+            {
+                return (closures_.size() + spare_closures_.size()) * closure_node_size + groups_.memory_usage();
+            }
+
+        protected:
+            static constexpr bool reentrant = is_reentrant<Signature>::value;
+
+            //Non-reentrant signatures only need the recursivity level for the
+            //checks of debug builds, unless they're grouped.
+#ifdef NDEBUG
+            static constexpr bool tracks_recursivity_level = reentrant || is_grouped<Signature>::value;
+#else
+            static constexpr bool tracks_recursivity_level = true;
+#endif
+
+            /*
+            An emission object must live as long as emit() iterates on the
+            closures.
+            The destruction of the outermost emission object cleans the
+            closure list in case remove_raw_event_closure() has been called
+            when we were calling slots, and moves the closures that have been
+            added meanwhile to their group.
+            */
+            class emission
+            {
+                public:
+                    emission(signal_leaf_base& leaf):
+                        leaf_(leaf)
                     {
-                        recursivity_level_incrementer(unsigned int& r):
-                            recursivity_level_(r)
+                        if constexpr(!reentrant)
                         {
-                            ++recursivity_level_;
+                            assert(leaf_.recursivity_level_ == 0 && "A non_reentrant signature has been emitted during its own emission.");
                         }
 
-                        ~recursivity_level_incrementer()
+                        if constexpr(tracks_recursivity_level)
                         {
-                            --recursivity_level_;
+                            ++leaf_.recursivity_level_;
                         }
 
-                        unsigned int& recursivity_level_;
-                    };
+#ifdef FGSIG_ENABLE_TRACING
+                        trace_session_id_ = trace_emission_begin<Signature>(depth());
+#endif
+                    }
 
-                    recursivity_level_incrementer rli{recursivity_level_};
+                    emission(const emission&) = delete;
 
-                    for(const auto& c: closures_)
-                        c.pf(c.pvslot, std::forward<Args>(args)...);
-                }
+                    emission& operator=(const emission&) = delete;
 
-                //Clean closure list in case remove_raw_event_closure() has
-                //been called when we were calling slots.
-                if(must_clean_closure_list_ && recursivity_level_ == 0)
-                {
-                    closures_.remove_if
-                    (
-                        [](const auto& c)
+                    ~emission()
+                    {
+#ifdef FGSIG_ENABLE_TRACING
+                        trace_emission_end<Signature>(depth(), trace_session_id_);
+#endif
+
+                        if constexpr(tracks_recursivity_level)
                         {
-                            return c.pf == &noop;
+                            if(--leaf_.recursivity_level_ == 0)
+                            {
+                                leaf_.groups_.insert_deferred(leaf_.closures_);
+                                if(leaf_.removed_closure_count_ != 0)
+                                    leaf_.erase_removed_closures();
+                            }
                         }
-                    );
-                    must_clean_closure_list_ = false;
-                }
+                    }
+
+                private:
+#ifdef FGSIG_ENABLE_TRACING
+                    //Non-reentrant signatures don't track their recursivity
+                    //level in release builds.
+                    unsigned int depth() const
+                    {
+                        return reentrant ? leaf_.recursivity_level_ : 1;
+                    }
+#endif
+
+                private:
+                    signal_leaf_base& leaf_;
+#ifdef FGSIG_ENABLE_TRACING
+                    //ID of the trace session that has recorded the beginning of
+                    //the emission, if any
+                    unsigned int trace_session_id_;
+#endif
+            };
+
+            static constexpr auto skipped_closure_pf = skipped_closure_function<function_signature_t<Signature>>::value;
+
+            //A std::list node holds two pointers in addition to the value.
+            static constexpr auto closure_node_size = sizeof(raw_closure<Signature>) + 2 * sizeof(void*);
+
+            //Whether the given ID predates a call to disconnect_all() or
+            //detach_all()
+            bool is_stale(const raw_closure_id<Signature> id) const
+            {
+                return id.generation != generation_;
             }
 
-            raw_closure_id<signature> add_raw_event_closure(const voidp_function_ptr<signature> pf, void* pvslot)
+        private:
+            //A null pvslot marks the closure as removed.
+            void mark_closure_as_removed(raw_closure<Signature>& c)
             {
-                closures_.emplace_back(pf, pvslot);
-                return std::prev(closures_.end());
+                if(c.pf != skipped_closure_pf)
+                    --live_closure_count_;
+
+                c.pf = skipped_closure_pf;
+                c.pvslot = nullptr;
+                ++removed_closure_count_;
             }
 
-            void remove_raw_event_closure(const raw_closure_id<signature> id)
+            void erase_removed_closures()
             {
-                if(recursivity_level_ == 0) //Are we iterating on closures_?
+                for(auto it = closures_.begin(); it != closures_.end();)
                 {
-                    //If not, erase right now.
-                    closures_.erase(id);
+                    const auto current = it++;
+                    if(current->pvslot == nullptr)
+                        release_closure(current);
                 }
+                removed_closure_count_ = 0;
+            }
+
+            //Erase the given closure, or keep its node for later use if we
+            //haven't reached the reserved capacity.
+            void release_closure(const typename raw_closure_list<Signature>::iterator it)
+            {
+                groups_.on_release(it);
+
+                if(it->pf != skipped_closure_pf)
+                    --live_closure_count_;
+
+                if(closures_.size() + spare_closures_.size() <= capacity_)
+                    spare_closures_.splice(spare_closures_.begin(), closures_, it);
                 else
+                    closures_.erase(it);
+            }
+
+        protected:
+            std::list<raw_closure<Signature>> closures_;
+
+        private:
+            std::list<raw_closure<Signature>> spare_closures_;
+            closure_groups<Signature> groups_;
+            std::size_t capacity_ = 0;
+            unsigned int recursivity_level_ = 0;
+
+            //Incremented by disconnect_all()
+            std::size_t generation_ = 0;
+
+            //Number of closures whose removal has been postponed
+            unsigned int removed_closure_count_ = 0;
+
+            //Number of closures that are neither blocked nor marked as removed
+            std::size_t live_closure_count_ = 0;
+    };
+
+    /*
+    signal_leaf adds the emit() function of a single signature to
+    signal_leaf_base.
+    */
+
+    template<typename Signature, typename LeafSignature = Signature>
+    struct signal_leaf;
+
+    template<typename R, typename... Args, typename LeafSignature>
+    struct signal_leaf<R(Args...), LeafSignature>:
+        public signal_leaf_base<LeafSignature>
+    {
+        static_assert(std::is_same_v<R, void>, "The return type of a signal signature must be void. Use fgsig::combined for other return types.");
+
+        public:
+            void emit(Args... args)
+            {
+                const auto e = typename signal_leaf::emission{*this};
+
+                //Call slots.
+                for(const auto& c: this->closures_)
+                    c.pf(c.pvslot, std::forward<Args>(args)...);
+            }
+    };
+
+    template<typename R, typename... Args, typename Combiner, typename LeafSignature>
+    struct signal_leaf<combined<R(Args...), Combiner>, LeafSignature>:
+        public signal_leaf_base<LeafSignature>
+    {
+        public:
+            auto emit(Args... args)
+            {
+                auto combiner = Combiner{};
+
                 {
-                    //If so, postpone erasing.
-                    id->pf = &noop;
-                    must_clean_closure_list_ = true;
+                    const auto e = typename signal_leaf::emission{*this};
+
+                    //Call slots until the combiner tells us to stop.
+                    for(const auto& c: this->closures_)
+                    {
+                        //Skip blocked and removed closures.
+                        if(c.pf == nullptr)
+                            continue;
+
+                        if(!combiner(c.pf(c.pvslot, std::forward<Args>(args)...)))
+                            break;
+                    }
+                }
+
+                return combiner.result();
+            }
+    };
+
+    template<typename Signature, typename LeafSignature>
+    struct signal_leaf<non_reentrant<Signature>, LeafSignature>:
+        public signal_leaf<Signature, LeafSignature>
+    {
+    };
+
+    template<typename Signature, typename LeafSignature>
+    struct signal_leaf<grouped<Signature>, LeafSignature>:
+        public signal_leaf<Signature, LeafSignature>
+    {
+    };
+
+    template<typename Signature, typename LeafSignature>
+    struct signal_leaf<inline_slots<Signature>, LeafSignature>:
+        public signal_leaf<Signature, LeafSignature>
+    {
+    };
+
+    /*
+    The destruction leaf notifies the connections of the destruction of the
+    signal.
+    detach_all() disconnects all the connections without notifying them: their
+    IDs become stale, so that closing them later doesn't remove any closure.
+    Since the connections still point to the signal, their detached closures
+    are notified when the signal is destroyed.
+    */
+    template<>
+    struct signal_leaf<destruction_signature>:
+        public signal_leaf<void(), destruction_signature>
+    {
+        private:
+            using base = signal_leaf<void(), destruction_signature>;
+
+        public:
+            void emit()
+            {
+                base::emit();
+                for(const auto& c: detached_closures_)
+                    c.pf(c.pvslot);
+            }
+
+            void detach_all()
+            {
+                erase_removed_detached_closures();
+                base::detach_all(detached_closures_);
+            }
+
+            void remove_raw_event_closure(const raw_closure_id<destruction_signature> id)
+            {
+                if(!is_stale(id))
+                {
+                    base::remove_raw_event_closure(id);
+                    return;
                 }
+
+                //Only mark detached closures as removed. detach_all() and
+                //shrink_to_fit() erase them.
+                id.it->pf = skipped_closure_pf;
+                id.it->pvslot = nullptr;
+                ++removed_detached_closure_count_;
+            }
+
+            void repoint_raw_event_closure(const raw_closure_id<destruction_signature> id, void* pvslot)
+            {
+                if(!is_stale(id))
+                    base::repoint_raw_event_closure(id, pvslot);
+                else if(id.it->pvslot != nullptr)
+                    id.it->pvslot = pvslot;
+            }
+
+            void shrink_to_fit()
+            {
+                base::shrink_to_fit();
+                erase_removed_detached_closures();
+            }
+
+            bool unused() const
+            {
+                return base::unused() && detached_closures_.empty();
+            }
+
+            std::size_t memory_usage() const
+            {
+                return base::memory_usage() + detached_closures_.size() * closure_node_size;
             }
 
         private:
-            static void noop(void*, Args...)
+            void erase_removed_detached_closures()
             {
+                if(removed_detached_closure_count_ == 0)
+                    return;
+
+                detached_closures_.remove_if
+                (
+                    [](const raw_closure<destruction_signature>& c)
+                    {
+                        return c.pvslot == nullptr;
+                    }
+                );
+                removed_detached_closure_count_ = 0;
             }
 
         private:
-            std::list<raw_closure<signature>> closures_;
-            unsigned int recursivity_level_ = 0;
-            bool must_clean_closure_list_ = false;
+            raw_closure_list<destruction_signature> detached_closures_;
+            std::size_t removed_detached_closure_count_ = 0;
+    };
+
+    /*
+    signal_state holds the closures of a signal.
+    It's allocated by the signal when the first connection is made, so that
+    an unconnected signal only holds a null pointer.
+    The leaves are direct bases (rather than bases of a recursive hierarchy) to
+    keep the number of instantiated types linear in the number of signatures.
+    */
+    template<typename... Signatures>
+    struct signal_state: public signal_leaf<Signatures>...
+    {
+        public:
+            using signal_leaf<Signatures>::emit...;
+            using signal_leaf<Signatures>::add_raw_event_closure...;
+            using signal_leaf<Signatures>::add_raw_event_closure_with_inline_slot...;
+            using signal_leaf<Signatures>::remove_raw_event_closure...;
+            using signal_leaf<Signatures>::block_raw_event_closure...;
+            using signal_leaf<Signatures>::unblock_raw_event_closure...;
+            using signal_leaf<Signatures>::repoint_raw_event_closure...;
+
+            //Notifies the connections of the destruction of the signal
+            signal_leaf<destruction_signature> destruction_subsignal;
+
+            //Notifies the connections of the destruction of the signal and of
+            //calls to disconnect_all(), for the ones that must know it right
+            //away (tracked subscriptions, to free themselves, and connection
+            //sets, to report their size)
+            signal_leaf<destruction_signature> disconnection_subsignal;
+    };
+
+    /*
+    signal_emitter provides the emit() function of a single signature to the
+    signal, which is given as Derived.
+    It's an empty class: it only checks whether the signal has a state before
+    forwarding the call to the corresponding leaf.
+    */
+
+    template<typename Derived, typename Signature, typename LeafSignature = Signature>
+    struct signal_emitter;
+
+    /*
+    Call the given emit function with the result of the given factory, which
+    is either the argument of the signature (if it has exactly one parameter)
+    or a tuple of the arguments.
+    Signatures without parameter have nothing to build: the factory is only
+    called for its side effects, and must return void.
+    */
+    template<std::size_t Arity, typename Factory, typename EmitFn>
+    decltype(auto) emit_factory_result(Factory& factory, EmitFn&& emit)
+    {
+        if constexpr(Arity == 0)
+        {
+            static_assert
+            (
+                std::is_void_v<std::invoke_result_t<Factory&>>,
+                "The factory of a signature without parameter must return void."
+            );
+            factory();
+            return emit();
+        }
+        else if constexpr(Arity == 1)
+        {
+            return emit(factory());
+        }
+        else
+        {
+            return std::apply(emit, factory());
+        }
+    }
+
+    template<typename Derived, typename R, typename... Args, typename LeafSignature>
+    struct signal_emitter<Derived, R(Args...), LeafSignature>
+    {
+        public:
+            void emit(Args... args)
+            {
+                if(const auto pstate = static_cast<Derived&>(*this).pstate_.get())
+                    static_cast<signal_leaf<LeafSignature>&>(*pstate).emit(std::forward<Args>(args)...);
+            }
+
+            template<typename Factory>
+            void emit_lazy(Factory& factory)
+            {
+                const auto pstate = static_cast<Derived&>(*this).pstate_.get();
+                if(!pstate)
+                    return;
+
+                auto& leaf = static_cast<signal_leaf<LeafSignature>&>(*pstate);
+                if(!leaf.has_live_closure())
+                    return;
+
+                emit_factory_result<sizeof...(Args)>
+                (
+                    factory,
+                    [&leaf](auto&&... args)
+                    {
+                        leaf.emit(std::forward<decltype(args)>(args)...);
+                    }
+                );
+            }
+    };
+
+    template<typename Derived, typename R, typename... Args, typename Combiner, typename LeafSignature>
+    struct signal_emitter<Derived, combined<R(Args...), Combiner>, LeafSignature>
+    {
+        public:
+            auto emit(Args... args)
+            {
+                if(const auto pstate = static_cast<Derived&>(*this).pstate_.get())
+                {
+                    return static_cast<signal_leaf<LeafSignature>&>(*pstate).emit
+                    (
+                        std::forward<Args>(args)...
+                    );
+                }
+
+                return Combiner{}.result();
+            }
+
+            template<typename Factory>
+            auto emit_lazy(Factory& factory)
+            {
+                if(const auto pstate = static_cast<Derived&>(*this).pstate_.get())
+                {
+                    auto& leaf = static_cast<signal_leaf<LeafSignature>&>(*pstate);
+                    if(leaf.has_live_closure())
+                    {
+                        return emit_factory_result<sizeof...(Args)>
+                        (
+                            factory,
+                            [&leaf](auto&&... args)
+                            {
+                                return leaf.emit(std::forward<decltype(args)>(args)...);
+                            }
+                        );
+                    }
+                }
+
+                return Combiner{}.result();
+            }
+    };
+
+    template<typename Derived, typename Signature, typename LeafSignature>
+    struct signal_emitter<Derived, non_reentrant<Signature>, LeafSignature>:
+        public signal_emitter<Derived, Signature, LeafSignature>
+    {
+    };
+
+    template<typename Derived, typename Signature, typename LeafSignature>
+    struct signal_emitter<Derived, grouped<Signature>, LeafSignature>:
+        public signal_emitter<Derived, Signature, LeafSignature>
+    {
+    };
+
+    template<typename Derived, typename Signature, typename LeafSignature>
+    struct signal_emitter<Derived, inline_slots<Signature>, LeafSignature>:
+        public signal_emitter<Derived, Signature, LeafSignature>
+    {
+    };
+
+    /*
+    Base type for signal
+    We have to use inheritance to let the compiler do the overload resolution
+    for the emit() member function.
+    Since the emitters are empty, the signal is as large as its state pointer.
+    */
+    template<typename Derived, typename... Signatures>
+    struct signal_base: public signal_emitter<Derived, Signatures>...
+    {
+        public:
+            using signal_emitter<Derived, Signatures>::emit...;
     };
 }
 
+template<typename Signal>
+struct emission_recorder;
+
 template<typename... Signatures>
 struct signal:
-    private detail::signal_base<Signatures...>
+    private detail::signal_base<signal<Signatures...>, Signatures...>
 {
     private:
-        template<typename Signal, typename Slot>
+        template<typename Signal>
+        friend struct emission_recorder;
+
+        template<typename Signal, typename Slot, typename SignatureList>
         friend struct connection;
 
+        template<typename Signal, typename Slot, typename SignatureList>
+        friend struct connection_set;
+
+        template<typename Signal, typename Slot, typename SignatureList>
+        friend struct detail::tracked_subscription;
+
+        template<typename Derived, typename Signature, typename LeafSignature>
+        friend struct detail::signal_emitter;
+
+        using state = detail::signal_state<Signatures...>;
+
     public:
         template<typename Slot>
         using connection = connection<signal, Slot>;
@@ -145,6 +1021,9 @@ struct signal:
         template<typename Slot>
         using owning_connection = owning_connection<signal, Slot>;
 
+        template<typename Slot>
+        using connection_set = connection_set<signal, Slot>;
+
     public:
         signal() = default;
 
@@ -160,44 +1039,416 @@ struct signal:
         {
             //Notify connections that the signal is destroyed so that they
             //don't try to call remove_*() functions.
-            destruction_subsignal_.emit();
+            if(pstate_)
+            {
+                pstate_->destruction_subsignal.emit();
+                pstate_->disconnection_subsignal.emit();
+            }
         }
 
-        using detail::signal_base<Signatures...>::emit;
+        using detail::signal_base<signal, Signatures...>::emit;
+
+        /*
+        Emit the result of factory() through the given signature, but only if
+        at least one of its slots would be called (i.e. is neither blocked nor
+        closed). Otherwise, factory() isn't called at all, which saves the
+        cost of building the arguments of an unobserved signature.
+        factory() returns the argument of the signature if the signature has
+        exactly one parameter, or a std::tuple of the arguments if it has
+        several. If the signature has no parameter, factory() must return
+        void.
+        */
+        template<typename Signature, typename Factory>
+        auto emit_lazy(Factory&& factory)
+        {
+            return static_cast<detail::signal_emitter<signal, Signature>&>(*this).emit_lazy(factory);
+        }
+
+        //Number of slots connected to the given signature
+        template<typename Signature>
+        std::size_t slot_count() const
+        {
+            if(!pstate_)
+                return 0;
+            return static_cast<const detail::signal_leaf<Signature>&>(*pstate_).slot_count();
+        }
+
+        //Whether no slot is connected to any signature
+        bool empty() const
+        {
+            return (slot_count<Signatures>() + ...) == 0;
+        }
+
+        /*
+        Close all the connections of the given signature.
+        Can be called during an emission. The slots that haven't been called
+        yet aren't called.
+        The connection objects aren't notified: their IDs become stale, so
+        that closing them later doesn't touch the signal.
+        */
+        template<typename Signature>
+        void disconnect_all()
+        {
+            if(pstate_)
+                static_cast<detail::signal_leaf<Signature>&>(*pstate_).disconnect_all();
+        }
+
+        /*
+        Close all the connections of all the signatures.
+        Like disconnect_all<Signature>(), it doesn't notify the connection
+        objects, so that closing them later doesn't touch the closure lists.
+        Only the trackable objects and the connection sets are notified.
+        */
+        void disconnect_all()
+        {
+            if(!pstate_)
+                return;
+
+            (static_cast<detail::signal_leaf<Signatures>&>(*pstate_).disconnect_all(), ...);
+
+            pstate_->destruction_subsignal.detach_all();
+            pstate_->disconnection_subsignal.emit();
+            pstate_->disconnection_subsignal.disconnect_all();
+        }
+
+        /*
+        Preallocate, for each signature, enough memory for n connections.
+        Connecting and disconnecting doesn't allocate nor deallocate memory as
+        long as there are no more than n connections per signature.
+        */
+        void reserve(const std::size_t n)
+        {
+            auto& s = get_state();
+            (static_cast<detail::signal_leaf<Signatures>&>(s).reserve(n), ...);
+            s.destruction_subsignal.reserve(n);
+            s.disconnection_subsignal.reserve(n);
+        }
+
+        /*
+        Free the memory preallocated by reserve().
+        Also free the whole state if there's no connection left.
+        */
+        void shrink_to_fit()
+        {
+            if(!pstate_)
+                return;
+
+            (static_cast<detail::signal_leaf<Signatures>&>(*pstate_).shrink_to_fit(), ...);
+            pstate_->destruction_subsignal.shrink_to_fit();
+            pstate_->disconnection_subsignal.shrink_to_fit();
+
+            const auto unused =
+                (static_cast<const detail::signal_leaf<Signatures>&>(*pstate_).unused() && ...) &&
+                pstate_->destruction_subsignal.unused() &&
+                pstate_->disconnection_subsignal.unused()
+            ;
+            if(unused)
+                pstate_.reset();
+        }
+
+        /*
+        Approximate number of bytes used by the signal, including dynamically
+        allocated memory.
+        Allocator overhead isn't taken into account.
+        */
+        std::size_t memory_usage() const
+        {
+            if(!pstate_)
+                return sizeof(*this);
+
+            return
+                sizeof(*this) +
+                sizeof(state) +
+                (static_cast<const detail::signal_leaf<Signatures>&>(*pstate_).memory_usage() + ...) +
+                pstate_->destruction_subsignal.memory_usage() +
+                pstate_->disconnection_subsignal.memory_usage()
+            ;
+        }
+
+    private:
+        /*
+        Number of emissions of any signature in progress, i.e. 1 when called
+        from a slot of a non-nested emission.
+        Emissions of non_reentrant signatures aren't counted in release builds.
+        */
+        unsigned int emission_depth() const
+        {
+            if(!pstate_)
+                return 0;
+            return (static_cast<const detail::signal_leaf<Signatures>&>(*pstate_).recursivity_level() + ...);
+        }
 
     private:
-        auto add_raw_destruction_closure(detail::voidp_function_ptr<void()> pf, void* pvconnection)
+        state& get_state()
+        {
+            if(!pstate_)
+                pstate_ = std::make_unique<state>();
+            return *pstate_;
+        }
+
+        /*
+        The following functions are called by the connections.
+        Adding a closure allocates the state if needed. The other functions are
+        only called with IDs returned by the former, so the state exists.
+        */
+
+        template<typename... Args>
+        auto add_raw_event_closure(Args... args)
+        {
+            return get_state().add_raw_event_closure(args...);
+        }
+
+        template<typename... Args>
+        auto add_raw_event_closure_with_inline_slot(const Args&... args)
+        {
+            return get_state().add_raw_event_closure_with_inline_slot(args...);
+        }
+
+        template<typename... Args>
+        void remove_raw_event_closure(Args... args)
+        {
+            pstate_->remove_raw_event_closure(args...);
+        }
+
+        template<typename... Args>
+        void block_raw_event_closure(Args... args)
+        {
+            pstate_->block_raw_event_closure(args...);
+        }
+
+        template<typename... Args>
+        void unblock_raw_event_closure(Args... args)
+        {
+            pstate_->unblock_raw_event_closure(args...);
+        }
+
+        template<typename... Args>
+        void repoint_raw_event_closure(Args... args)
+        {
+            pstate_->repoint_raw_event_closure(args...);
+        }
+
+        auto add_raw_destruction_closure(detail::voidp_function_ptr<detail::destruction_signature> pf, void* pvconnection)
+        {
+            return get_state().destruction_subsignal.add_raw_event_closure(pf, pvconnection);
+        }
+
+        void remove_raw_destruction_closure(const detail::raw_closure_id<detail::destruction_signature> id)
+        {
+            pstate_->destruction_subsignal.remove_raw_event_closure(id);
+        }
+
+        void repoint_raw_destruction_closure(const detail::raw_closure_id<detail::destruction_signature> id, void* pvconnection)
+        {
+            pstate_->destruction_subsignal.repoint_raw_event_closure(id, pvconnection);
+        }
+
+        auto add_raw_disconnection_closure(detail::voidp_function_ptr<detail::destruction_signature> pf, void* pvconnection)
         {
-            return destruction_subsignal_.add_raw_event_closure(pf, pvconnection);
+            return get_state().disconnection_subsignal.add_raw_event_closure(pf, pvconnection);
         }
 
-        void remove_raw_destruction_closure(const detail::raw_closure_id<void()> id)
+        void remove_raw_disconnection_closure(const detail::raw_closure_id<detail::destruction_signature> id)
         {
-            destruction_subsignal_.remove_raw_event_closure(id);
+            pstate_->disconnection_subsignal.remove_raw_event_closure(id);
+        }
+
+        void repoint_raw_disconnection_closure(const detail::raw_closure_id<detail::destruction_signature> id, void* pvconnection)
+        {
+            pstate_->disconnection_subsignal.repoint_raw_event_closure(id, pvconnection);
         }
 
     private:
-        detail::signal_base<void()> destruction_subsignal_;
+        std::unique_ptr<state> pstate_;
 };
 
+namespace detail
+{
+    //Whether the given type is a view (see signal_view.hpp)
+    template<typename T>
+    struct is_signal_view: std::false_type
+    {
+    };
+}
+
+namespace detail
+{
+    /*
+    Connect the given slot object to the given signatures of the given signal.
+    Slot is the type of the slot, which is the type of the slot object except
+    for member functions (see method_slot).
+    */
+    template<typename Slot, typename SignatureList, typename Signal, typename SlotObject>
+    auto connect_to_signatures(Signal& sig, SlotObject&& obj)
+    {
+        using decaid_signal_t = std::decay_t<Signal>;
+        using decaid_object_t = std::decay_t<SlotObject>;
+
+        static_assert(!std::is_const_v<Signal>);
+
+        if constexpr(std::is_rvalue_reference_v<decltype(obj)>)
+        {
+            static_assert
+            (
+                !std::is_base_of_v<trackable, decaid_object_t>,
+                "A trackable slot must be given as an lvalue reference."
+            );
+
+            return owning_connection<decaid_signal_t, Slot, SignatureList>{sig, std::move(obj)};
+        }
+        else if constexpr(std::is_base_of_v<trackable, decaid_object_t>)
+        {
+            //The trackable object keeps track of the connection.
+            track<decaid_signal_t, Slot, SignatureList>(sig, obj);
+        }
+        else
+        {
+            return connection<decaid_signal_t, Slot, SignatureList>{sig, obj};
+        }
+    }
+}
+
+/*
+Connect the given slot to all the signatures of the given signal.
+The slot must be callable with all of them.
+The returned connection owns the slot if the slot is given as an rvalue.
+If the slot is trackable, no connection is returned.
+*/
 template<typename Signal, typename Slot>
 auto connect(Signal& sig, Slot&& slot)
 {
     using decaid_signal_t = std::decay_t<Signal>;
     using decaid_slot_t = std::decay_t<Slot>;
 
-    static_assert(!std::is_const_v<Signal>);
+    if constexpr(detail::is_signal_view<decaid_signal_t>::value)
+    {
+        //Views connect the slot to their underlying signal.
+        return sig.connect(std::forward<Slot>(slot));
+    }
+    else
+    {
+        return detail::connect_to_signatures
+        <
+            decaid_slot_t,
+            detail::signal_signature_list_t<decaid_signal_t>
+        >(sig, std::forward<Slot>(slot));
+    }
+}
+
+/*
+Connect the given slot to the signatures of the given signal it can be called
+with:
+    auto c = fgsig::connect(sig, slot, fgsig::invocable_signatures);
+*/
+template<typename Signal, typename Slot>
+auto connect(Signal& sig, Slot&& slot, invocable_signatures_t)
+{
+    using decaid_signal_t = std::decay_t<Signal>;
+    using decaid_slot_t = std::decay_t<Slot>;
 
-    if constexpr(std::is_rvalue_reference_v<decltype(slot)>)
+    if constexpr(detail::is_signal_view<decaid_signal_t>::value)
     {
-        return owning_connection<decaid_signal_t, decaid_slot_t>{sig, std::move(slot)};
+        //Views always connect the slot to the signatures it can be called
+        //with.
+        return sig.connect(std::forward<Slot>(slot));
     }
     else
     {
-        return connection<decaid_signal_t, decaid_slot_t>{sig, slot};
+        return detail::connect_to_signatures
+        <
+            decaid_slot_t,
+            detail::invocable_signature_list_t<decaid_signal_t, decaid_slot_t>
+        >(sig, std::forward<Slot>(slot));
     }
 }
 
+/*
+Connect the given slot to the given signatures of the given signal only:
+    auto c = fgsig::connect(sig, slot, fgsig::signature_list<void(int)>{});
+*/
+template<typename Signal, typename Slot, typename... Signatures>
+auto connect(Signal& sig, Slot&& slot, signature_list<Signatures...>)
+{
+    return detail::connect_to_signatures
+    <
+        std::decay_t<Slot>,
+        signature_list<Signatures...>
+    >(sig, std::forward<Slot>(slot));
+}
+
+/*
+Connect the given member functions of the given object to the given signal.
+Each signature of the signal is connected to the first given member function
+that can be called with the arguments of the signature:
+    auto c = fgsig::connect<&receiver::on_event>(sig, receiver_object);
+There must be such a member function for each signature.
+The returned connection doesn't own the object.
+If the object is trackable, no connection is returned.
+*/
+template<auto Method, auto... Methods, typename Signal, typename T>
+auto connect(Signal& sig, T& obj)
+{
+    return detail::connect_to_signatures
+    <
+        detail::method_slot<T, Method, Methods...>,
+        detail::signal_signature_list_t<std::decay_t<Signal>>
+    >(sig, obj);
+}
+
+/*
+Connect the given member functions of the given object to the signatures of
+the given signal that one of them can be called with:
+    auto c = fgsig::connect<&receiver::on_event>(sig, receiver_object, fgsig::invocable_signatures);
+*/
+template<auto Method, auto... Methods, typename Signal, typename T>
+auto connect(Signal& sig, T& obj, invocable_signatures_t)
+{
+    using slot_t = detail::method_slot<T, Method, Methods...>;
+
+    return detail::connect_to_signatures
+    <
+        slot_t,
+        detail::invocable_signature_list_t<std::decay_t<Signal>, slot_t>
+    >(sig, obj);
+}
+
+/*
+Connect each slot of the given range to all the signatures of the given
+signal.
+The slots aren't owned by the returned connection_set, which closes all the
+connections at once.
+*/
+template<typename Signal, typename Range>
+auto connect_many(Signal& sig, Range& slots)
+{
+    using decaid_signal_t = std::decay_t<Signal>;
+    using slot_t = std::remove_reference_t<decltype(*std::begin(slots))>;
+
+    static_assert(!std::is_const_v<Signal>);
+    static_assert(!std::is_const_v<slot_t>);
+
+    return connection_set<decaid_signal_t, slot_t>{sig, slots};
+}
+
+//Like above, but only connect the slots to the signatures they can be called
+//with.
+template<typename Signal, typename Range>
+auto connect_many(Signal& sig, Range& slots, invocable_signatures_t)
+{
+    using decaid_signal_t = std::decay_t<Signal>;
+    using slot_t = std::remove_reference_t<decltype(*std::begin(slots))>;
+
+    static_assert(!std::is_const_v<Signal>);
+    static_assert(!std::is_const_v<slot_t>);
+
+    return connection_set
+    <
+        decaid_signal_t,
+        slot_t,
+        detail::invocable_signature_list_t<decaid_signal_t, slot_t>
+    >{sig, slots};
+}
+
 } //namespace
 
 #endif
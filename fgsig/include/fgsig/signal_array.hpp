@@ -0,0 +1,473 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_SIGNAL_ARRAY_HPP
+#define FGSIG_SIGNAL_ARRAY_HPP
+
+#include "signal.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    using signal_array_index = std::uint32_t;
+
+    //Index of no closure
+    constexpr auto signal_array_npos = static_cast<signal_array_index>(-1);
+
+    /*
+    signal_array_leaf holds the closures of a single signature, for all the
+    entities.
+    The closures are stored in a single table, laid out as a structure of
+    arrays. The closures of an entity are chained with next_, from heads_[entity].
+    Unused rows of the table call a function that does nothing, so that
+    emit_all() can call every row without checking it.
+    */
+    template<typename Signature>
+    struct signal_array_leaf;
+
+    template<typename R, typename... Args>
+    struct signal_array_leaf<R(Args...)>
+    {
+        static_assert(std::is_same_v<R, void>, "The signatures of a signal_array must return void.");
+
+        private:
+            using signature = R(Args...);
+
+            static constexpr auto skipped_closure_pf = skipped_closure_function<signature>::value;
+
+            //See signal_leaf_base::emission.
+            class emission
+            {
+                public:
+                    emission(signal_array_leaf& leaf):
+                        leaf_(leaf)
+                    {
+                        ++leaf_.recursivity_level_;
+
+#ifdef FGSIG_ENABLE_TRACING
+                        trace_session_id_ = trace_emission_begin<signature>(leaf_.recursivity_level_);
+#endif
+                    }
+
+                    emission(const emission&) = delete;
+
+                    emission& operator=(const emission&) = delete;
+
+                    ~emission()
+                    {
+#ifdef FGSIG_ENABLE_TRACING
+                        trace_emission_end<signature>(leaf_.recursivity_level_, trace_session_id_);
+#endif
+
+                        if(--leaf_.recursivity_level_ == 0 && !leaf_.removed_closures_.empty())
+                            leaf_.release_removed_closures();
+                    }
+
+                private:
+                    signal_array_leaf& leaf_;
+#ifdef FGSIG_ENABLE_TRACING
+                    //ID of the trace session that has recorded the beginning of
+                    //the emission, if any
+                    unsigned int trace_session_id_;
+#endif
+            };
+
+        public:
+            explicit signal_array_leaf(const std::size_t entity_count):
+                heads_(entity_count, signal_array_npos)
+            {
+            }
+
+            //Call the slots of the given entity.
+            void emit(const std::size_t entity, Args... args)
+            {
+                const auto e = emission{*this};
+
+                //Slots may connect other slots, which may reallocate the
+                //arrays. Don't keep any pointer to the elements.
+                for(auto i = heads_[entity]; i != signal_array_npos; i = next_[i])
+                    pfs_[i](pvslots_[i], std::forward<Args>(args)...);
+            }
+
+            /*
+            Call the slots of all the entities, in the order of the table.
+            A slot that is connected during the emission is called if it takes
+            a new row, but not if it reuses a row that has already been swept.
+            */
+            void emit_all(Args... args)
+            {
+                const auto e = emission{*this};
+
+                for(auto i = std::size_t{0}; i < pfs_.size(); ++i)
+                    pfs_[i](pvslots_[i], std::forward<Args>(args)...);
+            }
+
+            signal_array_index add_closure(const std::size_t entity, const voidp_function_ptr<signature> pf, void* pvslot)
+            {
+                auto i = signal_array_npos;
+                if(free_rows_.empty())
+                {
+                    i = static_cast<signal_array_index>(pfs_.size());
+                    pfs_.push_back(pf);
+                    pvslots_.push_back(pvslot);
+                    next_.push_back(signal_array_npos);
+                }
+                else
+                {
+                    i = free_rows_.back();
+                    free_rows_.pop_back();
+                    pfs_[i] = pf;
+                    pvslots_[i] = pvslot;
+                    next_[i] = signal_array_npos;
+                }
+
+                //Append the closure to the chain of the entity.
+                auto pnext = &heads_[entity];
+                while(*pnext != signal_array_npos)
+                    pnext = &next_[*pnext];
+                *pnext = i;
+
+                ++slot_count_;
+
+                return i;
+            }
+
+            void remove_closure(const std::size_t entity, const signal_array_index i)
+            {
+                --slot_count_;
+
+                if(recursivity_level_ == 0)
+                {
+                    release_closure(entity, i);
+                }
+                else
+                {
+                    //Postpone the removal, since we may be iterating on the
+                    //chain of the entity.
+                    pfs_[i] = skipped_closure_pf;
+                    pvslots_[i] = nullptr;
+                    removed_closures_.push_back({entity, i});
+                }
+            }
+
+            void repoint_closure(const signal_array_index i, void* pvslot)
+            {
+                pvslots_[i] = pvslot;
+            }
+
+            std::size_t slot_count() const
+            {
+                return slot_count_;
+            }
+
+            //Size of dynamically allocated memory, in bytes
+            std::size_t memory_usage() const
+            {
+                return
+                    pfs_.capacity() * sizeof(voidp_function_ptr<signature>) +
+                    pvslots_.capacity() * sizeof(void*) +
+                    (next_.capacity() + heads_.capacity() + free_rows_.capacity()) * sizeof(signal_array_index) +
+                    removed_closures_.capacity() * sizeof(removed_closure)
+                ;
+            }
+
+        private:
+            struct removed_closure
+            {
+                std::size_t entity;
+                signal_array_index row;
+            };
+
+            void release_closure(const std::size_t entity, const signal_array_index i)
+            {
+                //Unlink the closure from the chain of the entity.
+                auto pnext = &heads_[entity];
+                while(*pnext != i)
+                    pnext = &next_[*pnext];
+                *pnext = next_[i];
+
+                pfs_[i] = skipped_closure_pf;
+                pvslots_[i] = nullptr;
+                free_rows_.push_back(i);
+            }
+
+            void release_removed_closures()
+            {
+                for(const auto& c: removed_closures_)
+                    release_closure(c.entity, c.row);
+                removed_closures_.clear();
+            }
+
+        private:
+            //Table of closures
+            std::vector<voidp_function_ptr<signature>> pfs_;
+            std::vector<void*> pvslots_;
+            std::vector<signal_array_index> next_;
+
+            //First closure of each entity
+            std::vector<signal_array_index> heads_;
+
+            std::vector<signal_array_index> free_rows_;
+            std::vector<removed_closure> removed_closures_;
+            std::size_t slot_count_ = 0;
+            unsigned int recursivity_level_ = 0;
+    };
+
+    template<typename Signature>
+    struct signal_array_index_holder
+    {
+        using index_type = signal_array_index;
+
+        signal_array_index index;
+    };
+
+    //Flat set of one table index per signature (see raw_closure_id_set)
+    template<typename... Signatures>
+    struct signal_array_index_set: signal_array_index_holder<Signatures>...
+    {
+        signal_array_index_set(const typename signal_array_index_holder<Signatures>::index_type... indexes):
+            signal_array_index_holder<Signatures>{indexes}...
+        {
+        }
+
+        template<typename Signature>
+        signal_array_index get() const
+        {
+            return static_cast<const signal_array_index_holder<Signature>&>(*this).index;
+        }
+    };
+}
+
+template
+<
+    typename SignalArray,
+    typename Slot,
+    typename SignatureList = detail::signal_signature_list_t<SignalArray>
+>
+struct signal_array_connection;
+
+/*
+signal_array manages the signals of many entities, identified by their index
+in [0, size()).
+All the closures of a given signature are stored in a single table, whose
+columns are contiguous arrays. An entity only costs an index per signature.
+emit(entity, args...) calls the slots of the given entity, and emit_all(args...)
+calls the slots of all the entities by sweeping the table.
+Only void signatures are supported.
+*/
+template<typename... Signatures>
+struct signal_array:
+    private detail::signal_array_leaf<Signatures>...
+{
+    private:
+        template<typename SignalArray, typename Slot, typename SignatureList>
+        friend struct signal_array_connection;
+
+    public:
+        explicit signal_array(const std::size_t entity_count):
+            detail::signal_array_leaf<Signatures>(entity_count)...,
+            entity_count_(entity_count)
+        {
+        }
+
+        signal_array(const signal_array&) = delete;
+
+        signal_array(signal_array&&) = delete;
+
+        signal_array& operator=(const signal_array&) = delete;
+
+        signal_array& operator=(signal_array&&) = delete;
+
+        ~signal_array()
+        {
+            //Notify connections that the signal array is destroyed.
+            destruction_subsignal_.emit();
+        }
+
+        using detail::signal_array_leaf<Signatures>::emit...;
+        using detail::signal_array_leaf<Signatures>::emit_all...;
+
+        /*
+        Connect the given slot to the signal of the given entity.
+        Like fgsig::connect(), connect the slot to all the signatures, or to
+        the ones it can be called with if fgsig::invocable_signatures is
+        given.
+        The returned connection owns the slot if it's given as an rvalue.
+        */
+        template<typename Slot>
+        auto connect(const std::size_t entity, Slot&& slot)
+        {
+            return signal_array_connection<signal_array, stored_slot_t<decltype(slot)>>{*this, entity, std::forward<Slot>(slot)};
+        }
+
+        template<typename Slot>
+        auto connect(const std::size_t entity, Slot&& slot, invocable_signatures_t)
+        {
+            using slot_t = stored_slot_t<decltype(slot)>;
+            using signature_list_t = detail::invocable_signature_list_t<signal_array, std::remove_reference_t<slot_t>>;
+            return signal_array_connection<signal_array, slot_t, signature_list_t>{*this, entity, std::forward<Slot>(slot)};
+        }
+
+        //Number of entities
+        std::size_t size() const
+        {
+            return entity_count_;
+        }
+
+        //Number of slots connected to the given signature, for all entities
+        template<typename Signature>
+        std::size_t slot_count() const
+        {
+            return static_cast<const detail::signal_array_leaf<Signature>&>(*this).slot_count();
+        }
+
+        /*
+        Approximate number of bytes used by the signal array, including
+        dynamically allocated memory.
+        */
+        std::size_t memory_usage() const
+        {
+            return
+                sizeof(*this) +
+                (static_cast<const detail::signal_array_leaf<Signatures>&>(*this).memory_usage() + ...) +
+                destruction_subsignal_.memory_usage()
+            ;
+        }
+
+    private:
+        //Own rvalue slots, reference lvalue ones.
+        template<typename Slot>
+        using stored_slot_t = std::conditional_t
+        <
+            std::is_rvalue_reference_v<Slot>,
+            std::decay_t<Slot>,
+            Slot
+        >;
+
+        template<typename Signature>
+        detail::signal_array_leaf<Signature>& leaf()
+        {
+            return *this;
+        }
+
+    private:
+        std::size_t entity_count_;
+        detail::signal_leaf<detail::destruction_signature> destruction_subsignal_;
+};
+
+/*
+signal_array_connection establishes a connection between the signal of an
+entity of a signal_array and the given slot.
+Slot is either an object type (the slot is owned) or an lvalue reference type.
+Its destructor closes the connection.
+*/
+template
+<
+    template<typename...> typename SignalArrayTpl,
+    typename... SignalArraySignatures,
+    typename Slot,
+    typename... Signatures
+>
+struct signal_array_connection<SignalArrayTpl<SignalArraySignatures...>, Slot, signature_list<Signatures...>>
+{
+    static_assert(sizeof...(Signatures) != 0, "The slot can't be called with any signature of the signal array.");
+
+    static_assert
+    (
+        (detail::is_slot_invocable<std::remove_reference_t<Slot>, Signatures>::value && ...),
+        "The slot can't be called with all the signatures it's connected to. Give fgsig::invocable_signatures to connect() to only connect it to the signatures it can be called with."
+    );
+
+    private:
+        using signal_array = SignalArrayTpl<SignalArraySignatures...>;
+        using slot_object = std::remove_reference_t<Slot>;
+
+    public:
+        template<typename Slot2>
+        signal_array_connection(signal_array& sigs, const std::size_t entity, Slot2&& slot):
+            psignals_(&sigs),
+            entity_(entity),
+            slot_(std::forward<Slot2>(slot)),
+            indexes_
+            (
+                sigs.template leaf<Signatures>().add_closure
+                (
+                    entity,
+                    &detail::slot_caller<slot_object, Signatures>::call,
+                    &slot_
+                )...
+            ),
+            destruction_closure_id_
+            (
+                sigs.destruction_subsignal_.add_raw_event_closure(&on_signal_array_destruction, this)
+            )
+        {
+        }
+
+        signal_array_connection(const signal_array_connection&) = delete;
+
+        //Take over the closures of r and make them call the new slot.
+        signal_array_connection(signal_array_connection&& r):
+            psignals_(r.psignals_),
+            entity_(r.entity_),
+            slot_(std::forward<Slot>(r.slot_)),
+            indexes_(r.indexes_),
+            destruction_closure_id_(r.destruction_closure_id_)
+        {
+            if(psignals_)
+            {
+                (psignals_->template leaf<Signatures>().repoint_closure(indexes_.template get<Signatures>(), &slot_), ...);
+                psignals_->destruction_subsignal_.repoint_raw_event_closure(destruction_closure_id_, this);
+                r.psignals_ = nullptr;
+            }
+        }
+
+        signal_array_connection& operator=(const signal_array_connection&) = delete;
+
+        signal_array_connection& operator=(signal_array_connection&&) = delete;
+
+        ~signal_array_connection()
+        {
+            close();
+        }
+
+        void close()
+        {
+            if(psignals_)
+            {
+                psignals_->destruction_subsignal_.remove_raw_event_closure(destruction_closure_id_);
+                (psignals_->template leaf<Signatures>().remove_closure(entity_, indexes_.template get<Signatures>()), ...);
+                psignals_ = nullptr;
+            }
+        }
+
+    private:
+        static void on_signal_array_destruction(void* pvself)
+        {
+            auto& self = *reinterpret_cast<signal_array_connection*>(pvself);
+            self.psignals_ = nullptr;
+        }
+
+    private:
+        //Set to nullptr when connection is closed or moved from.
+        signal_array* psignals_;
+
+        std::size_t entity_;
+        Slot slot_;
+        detail::signal_array_index_set<Signatures...> indexes_;
+        detail::raw_closure_id<detail::destruction_signature> destruction_closure_id_;
+};
+
+} //namespace
+
+#endif
@@ -0,0 +1,207 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_SIGNAL_VIEW_HPP
+#define FGSIG_SIGNAL_VIEW_HPP
+
+#include "signal.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace fgsig
+{
+
+template<typename Source, typename Predicate>
+struct filter_view;
+
+template<typename Source, typename Function>
+struct transform_view;
+
+namespace detail
+{
+    template<typename Source, typename Predicate>
+    struct is_signal_view<filter_view<Source, Predicate>>: std::true_type
+    {
+    };
+
+    template<typename Source, typename Function>
+    struct is_signal_view<transform_view<Source, Function>>: std::true_type
+    {
+    };
+
+    /*
+    A view holds the view it's built upon by value, and the signal it's built
+    upon by reference.
+    */
+    template<typename Source>
+    using view_source_t = std::conditional_t
+    <
+        is_signal_view<Source>::value,
+        Source,
+        Source&
+    >;
+
+    //Own rvalue slots, reference lvalue ones.
+    template<typename Slot>
+    using view_slot_t = std::conditional_t
+    <
+        std::is_lvalue_reference_v<Slot>,
+        Slot,
+        std::decay_t<Slot>
+    >;
+
+    /*
+    filtering_slot is the slot that a filter_view connects to its source.
+    Its call operator is constrained so that it's only connected to the
+    signatures both the predicate and the slot can be called with.
+    */
+    template<typename Predicate, typename Slot>
+    struct filtering_slot
+    {
+        template
+        <
+            typename... Args,
+            typename = std::enable_if_t
+            <
+                std::is_invocable_r_v<bool, Predicate&, const std::remove_reference_t<Args>&...> &&
+                std::is_invocable_v<std::remove_reference_t<Slot>&, Args...>
+            >
+        >
+        void operator()(Args&&... args)
+        {
+            if(pred(std::as_const(args)...))
+                slot(std::forward<Args>(args)...);
+        }
+
+        Predicate pred;
+        Slot slot;
+    };
+
+    /*
+    transforming_slot is the slot that a transform_view connects to its source.
+    */
+    template<typename Function, typename Slot>
+    struct transforming_slot
+    {
+        template
+        <
+            typename... Args,
+            typename = std::enable_if_t
+            <
+                std::is_invocable_v<std::remove_reference_t<Slot>&, std::invoke_result_t<Function&, Args...>>
+            >
+        >
+        void operator()(Args&&... args)
+        {
+            slot(fn(std::forward<Args>(args)...));
+        }
+
+        Function fn;
+        Slot slot;
+    };
+}
+
+/*
+filter_view is a view of a signal (or of another view) that only forwards the
+emissions whose arguments satisfy the given predicate.
+It isn't a signal: connecting a slot to the view connects the slot, wrapped
+with the predicate, directly to the underlying signal. Therefore, the signal
+doesn't call anything on behalf of a view that has no connected slot.
+The returned connection is an owning_connection to the underlying signal, which
+owns the slot if it's given as an rvalue.
+The underlying signal must outlive the view.
+*/
+template<typename Source, typename Predicate>
+struct filter_view
+{
+    public:
+        template<typename Source2>
+        filter_view(Source2&& source, Predicate pred):
+            source_(std::forward<Source2>(source)),
+            pred_(std::move(pred))
+        {
+        }
+
+        template<typename Slot>
+        auto connect(Slot&& slot) const
+        {
+            using filtering_slot = detail::filtering_slot<Predicate, detail::view_slot_t<Slot>>;
+            return fgsig::connect(source_, filtering_slot{pred_, std::forward<Slot>(slot)}, invocable_signatures);
+        }
+
+    private:
+        detail::view_source_t<Source> source_;
+        Predicate pred_;
+};
+
+/*
+transform_view is a view of a signal (or of another view) that forwards the
+result of the given function, called with the arguments of each emission.
+Like filter_view, it doesn't connect anything to the underlying signal by
+itself.
+*/
+template<typename Source, typename Function>
+struct transform_view
+{
+    public:
+        template<typename Source2>
+        transform_view(Source2&& source, Function fn):
+            source_(std::forward<Source2>(source)),
+            fn_(std::move(fn))
+        {
+        }
+
+        template<typename Slot>
+        auto connect(Slot&& slot) const
+        {
+            using transforming_slot = detail::transforming_slot<Function, detail::view_slot_t<Slot>>;
+            return fgsig::connect(source_, transforming_slot{fn_, std::forward<Slot>(slot)}, invocable_signatures);
+        }
+
+    private:
+        detail::view_source_t<Source> source_;
+        Function fn_;
+};
+
+/*
+Make a filter_view of the given signal or view:
+    auto low_fuel = fgsig::filter(fuel_level, [](double level){return level < 10;});
+    auto c = fgsig::connect(low_fuel, slot);
+*/
+template<typename Source, typename Predicate>
+auto filter(Source&& source, Predicate pred)
+{
+    return filter_view<std::remove_reference_t<Source>, Predicate>{std::forward<Source>(source), std::move(pred)};
+}
+
+//Make a transform_view of the given signal or view.
+template<typename Source, typename Function>
+auto transform(Source&& source, Function fn)
+{
+    return transform_view<std::remove_reference_t<Source>, Function>{std::forward<Source>(source), std::move(fn)};
+}
+
+/*
+Connect the given slot to the given view.
+These overloads accept temporary views. Lvalue views can also be given to the
+generic connect().
+*/
+
+template<typename Source, typename Predicate, typename Slot>
+auto connect(const filter_view<Source, Predicate>& view, Slot&& slot)
+{
+    return view.connect(std::forward<Slot>(slot));
+}
+
+template<typename Source, typename Function, typename Slot>
+auto connect(const transform_view<Source, Function>& view, Slot&& slot)
+{
+    return view.connect(std::forward<Slot>(slot));
+}
+
+} //namespace
+
+#endif
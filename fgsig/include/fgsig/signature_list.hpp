@@ -0,0 +1,49 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_SIGNATURE_LIST_HPP
+#define FGSIG_SIGNATURE_LIST_HPP
+
+namespace fgsig
+{
+
+/*
+signature_list is a list of signatures of a signal.
+Give it to fgsig::connect() to connect a slot to these signatures only:
+    auto c = fgsig::connect(sig, slot, fgsig::signature_list<void(int)>{});
+*/
+template<typename... Signatures>
+struct signature_list
+{
+};
+
+/*
+By default, a slot is connected to all the signatures of the signal, and must
+be callable with all of them.
+Give invocable_signatures to fgsig::connect() to connect the slot to the
+signatures it can be called with only (there must be at least one):
+    auto c = fgsig::connect(sig, slot, fgsig::invocable_signatures);
+*/
+struct invocable_signatures_t
+{
+};
+
+inline constexpr auto invocable_signatures = invocable_signatures_t{};
+
+namespace detail
+{
+    //Concatenation of signature lists, meant to be used in fold expressions
+    template<typename... Signatures, typename... Signatures2>
+    signature_list<Signatures..., Signatures2...> operator+
+    (
+        signature_list<Signatures...>,
+        signature_list<Signatures2...>
+    );
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,46 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_STRAND_HPP
+#define FGSIG_STRAND_HPP
+
+#include "detail/serial_queue.hpp"
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace fgsig
+{
+
+/*
+strand is an executor that runs the tasks posted to it on the given executor,
+one after the other, in the order they've been posted.
+Copies of a strand refer to the same queue.
+The given executor must outlive the strand and the tasks posted to it.
+An exception thrown by a task propagates to the given executor, and doesn't
+keep the next tasks from running.
+*/
+template<typename Executor>
+struct strand
+{
+    public:
+        strand(Executor& executor):
+            pqueue_(std::make_shared<detail::serial_queue<Executor>>(executor))
+        {
+        }
+
+        void post(std::function<void()> task)
+        {
+            pqueue_->post(std::move(task));
+        }
+
+    private:
+        std::shared_ptr<detail::serial_queue<Executor>> pqueue_;
+};
+
+} //namespace
+
+#endif
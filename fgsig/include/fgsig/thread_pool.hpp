@@ -0,0 +1,82 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_THREAD_POOL_HPP
+#define FGSIG_THREAD_POOL_HPP
+
+#include "detail/worker_threads.hpp"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace fgsig
+{
+
+/*
+thread_pool is an executor that runs the tasks posted to it on a fixed number
+of threads.
+Tasks may run concurrently and in any order. Post them through a strand to
+run them one after the other.
+The destructor runs the pending tasks, then joins the threads.
+*/
+struct thread_pool
+{
+    public:
+        //Throw std::invalid_argument if the given number of threads is zero.
+        explicit thread_pool(const std::size_t thread_count = detail::default_thread_count()):
+            workers_(thread_count, [this](std::size_t){run();})
+        {
+        }
+
+        thread_pool(const thread_pool&) = delete;
+
+        thread_pool(thread_pool&&) = delete;
+
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        thread_pool& operator=(thread_pool&&) = delete;
+
+        void post(std::function<void()> task)
+        {
+            {
+                const auto lock = std::lock_guard<std::mutex>{workers_.mutex()};
+                tasks_.push_back(std::move(task));
+            }
+            workers_.notify_one();
+        }
+
+    private:
+        void run()
+        {
+            auto lock = std::unique_lock<std::mutex>{workers_.mutex()};
+            while(true)
+            {
+                workers_.wait(lock, [this]{return !tasks_.empty();});
+
+                if(tasks_.empty())
+                    return; //We're stopping and there's nothing left to do.
+
+                auto task = std::move(tasks_.front());
+                tasks_.pop_front();
+
+                lock.unlock();
+                task();
+                lock.lock();
+            }
+        }
+
+    private:
+        std::deque<std::function<void()>> tasks_;
+
+        //Declared last, so that the threads are joined first.
+        detail::worker_threads workers_;
+};
+
+} //namespace
+
+#endif
@@ -0,0 +1,371 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_TRACING_HPP
+#define FGSIG_TRACING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+Tracing records a begin and an end event for every emission of a signal and
+every slot call, so that the timeline of nested emissions can be displayed by a
+Chrome trace viewer (chrome://tracing, https://ui.perfetto.dev).
+Signals and connections only call the tracing hooks if FGSIG_ENABLE_TRACING is
+defined (in every translation unit). Otherwise, the hooks aren't compiled at
+all, and the functions of this file produce empty traces.
+*/
+
+namespace fgsig
+{
+
+namespace detail
+{
+    //Extract T from the name of type_name<T>().
+    inline std::string type_name_from_function_name(const std::string_view function_name)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        const auto begin = function_name.find("type_name<") + 10;
+        const auto end = function_name.rfind(">(void)");
+#else
+        const auto begin = function_name.find("T = ") + 4;
+        const auto end = function_name.rfind(']');
+#endif
+        return std::string{function_name.substr(begin, end - begin)};
+    }
+
+    //Human-readable name of T
+    template<typename T>
+    const char* type_name()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        static const auto name = type_name_from_function_name(__FUNCSIG__);
+#else
+        static const auto name = type_name_from_function_name(__PRETTY_FUNCTION__);
+#endif
+        return name.c_str();
+    }
+
+    struct trace_event
+    {
+        //Type name of the signature or slot, with static storage duration
+        const char* name;
+
+        //"emit" or "slot"
+        const char* category;
+
+        //Nanoseconds since start_tracing()
+        std::int64_t timestamp;
+
+        std::uint32_t depth;
+
+        //'B' (begin) or 'E' (end)
+        char phase;
+    };
+
+    /*
+    trace_buffer holds the events of a single thread.
+    Only this thread writes in it, and it never reallocates, so that the
+    events can be read by write_chrome_trace() while being recorded without any
+    lock: an event is visible once size has been incremented.
+    Events that don't fit are dropped.
+    */
+    struct trace_buffer
+    {
+        trace_buffer(const std::size_t capacity, const std::uint32_t thread_index):
+            events(capacity),
+            thread_index(thread_index)
+        {
+        }
+
+        std::vector<trace_event> events;
+        std::atomic<std::size_t> size{0};
+        std::atomic<std::size_t> dropped_event_count{0};
+        std::uint32_t thread_index;
+    };
+
+    struct trace_session
+    {
+        std::atomic<bool> enabled{false};
+
+        //Incremented by start_tracing(), so that threads register a new buffer.
+        std::atomic<unsigned int> id{0};
+
+        std::atomic<std::int64_t> start_time{0};
+
+        //Protects the members below. Only locked once per thread and session,
+        //and by write_chrome_trace().
+        std::mutex mutex;
+
+        std::vector<std::shared_ptr<trace_buffer>> buffers;
+        std::size_t events_per_thread = 0;
+    };
+
+    inline trace_session& get_trace_session()
+    {
+        static auto session = trace_session{};
+        return session;
+    }
+
+    struct thread_trace_state
+    {
+        std::shared_ptr<trace_buffer> pbuffer;
+        unsigned int session_id = 0;
+
+        //Number of emissions in progress in this thread
+        std::uint32_t emission_depth = 0;
+    };
+
+    inline thread_trace_state& get_thread_trace_state()
+    {
+        thread_local auto state = thread_trace_state{};
+        return state;
+    }
+
+    inline std::int64_t trace_clock_now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>
+        (
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    inline void record_trace_event
+    (
+        trace_session& session,
+        const char* name,
+        const char* category,
+        const std::uint32_t depth,
+        const char phase
+    )
+    {
+        auto& local = get_thread_trace_state();
+
+        const auto session_id = session.id.load(std::memory_order_acquire);
+        if(local.session_id != session_id)
+        {
+            const auto lock = std::lock_guard<std::mutex>{session.mutex};
+            local.pbuffer = std::make_shared<trace_buffer>
+            (
+                session.events_per_thread,
+                static_cast<std::uint32_t>(session.buffers.size())
+            );
+            local.session_id = session_id;
+            session.buffers.push_back(local.pbuffer);
+        }
+
+        auto& buffer = *local.pbuffer;
+        const auto i = buffer.size.load(std::memory_order_relaxed);
+        if(i == buffer.events.size())
+        {
+            buffer.dropped_event_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.events[i] = trace_event
+        {
+            name,
+            category,
+            trace_clock_now() - session.start_time.load(std::memory_order_relaxed),
+            depth,
+            phase
+        };
+        buffer.size.store(i + 1, std::memory_order_release);
+    }
+
+    /*
+    Tracing hooks
+    The depth of an emission is the recursivity level of the emitted signature
+    (1 for the outermost emission). The depth of a slot call is the number of
+    emissions in progress in the calling thread.
+    An end event is recorded if and only if the matching begin event has been
+    recorded in the same session, so that starting or stopping the tracing
+    during an emission doesn't produce unmatched events.
+    trace_emission_begin() returns the ID of the session that has recorded its
+    event (0 if none), which must be given to trace_emission_end().
+    */
+
+    inline unsigned int current_trace_session_id(trace_session& session)
+    {
+        return session.enabled.load(std::memory_order_acquire) ?
+            session.id.load(std::memory_order_acquire) :
+            0
+        ;
+    }
+
+    template<typename Signature>
+    unsigned int trace_emission_begin(const unsigned int depth)
+    {
+        ++get_thread_trace_state().emission_depth;
+
+        auto& session = get_trace_session();
+        const auto session_id = current_trace_session_id(session);
+        if(session_id != 0)
+            record_trace_event(session, type_name<Signature>(), "emit", depth, 'B');
+        return session_id;
+    }
+
+    template<typename Signature>
+    void trace_emission_end(const unsigned int depth, const unsigned int begin_session_id)
+    {
+        --get_thread_trace_state().emission_depth;
+
+        auto& session = get_trace_session();
+        if(begin_session_id != 0 && begin_session_id == session.id.load(std::memory_order_acquire))
+            record_trace_event(session, type_name<Signature>(), "emit", depth, 'E');
+    }
+
+    //Records the call of a slot of type Slot, from its construction to its
+    //destruction.
+    template<typename Slot>
+    class slot_call_trace
+    {
+        public:
+            slot_call_trace():
+                session_id_(current_trace_session_id(get_trace_session()))
+            {
+                if(session_id_ != 0)
+                    record('B');
+            }
+
+            slot_call_trace(const slot_call_trace&) = delete;
+
+            slot_call_trace& operator=(const slot_call_trace&) = delete;
+
+            ~slot_call_trace()
+            {
+                auto& session = get_trace_session();
+                if(session_id_ != 0 && session_id_ == session.id.load(std::memory_order_acquire))
+                    record('E');
+            }
+
+        private:
+            static void record(const char phase)
+            {
+                const auto depth = get_thread_trace_state().emission_depth;
+                record_trace_event(get_trace_session(), type_name<Slot>(), "slot", depth, phase);
+            }
+
+        private:
+            unsigned int session_id_;
+    };
+
+    /*
+    Write the given number of nanoseconds as microseconds, with nanosecond
+    precision.
+    Events that are recorded by another thread while start_tracing() runs can
+    be timestamped before the start of the session, hence the sign.
+    */
+    inline void write_trace_timestamp(std::ostream& out, const std::int64_t timestamp)
+    {
+        //Computed on the magnitude, so that -1500 gives -1.500 and not -1.-500.
+        const auto magnitude = timestamp < 0 ?
+            std::uint64_t{0} - static_cast<std::uint64_t>(timestamp) :
+            static_cast<std::uint64_t>(timestamp)
+        ;
+        const auto ns = magnitude % 1000;
+
+        if(timestamp < 0)
+            out << '-';
+        out << magnitude / 1000 << '.' << (ns < 100 ? "0" : "") << (ns < 10 ? "0" : "") << ns;
+    }
+
+    inline void write_json_string(std::ostream& out, const char* str)
+    {
+        out << '"';
+        for(; *str != '\0'; ++str)
+        {
+            if(*str == '"' || *str == '\\')
+                out << '\\';
+            out << *str;
+        }
+        out << '"';
+    }
+}
+
+/*
+Discard the events recorded so far and start recording, with room for the given
+number of events per thread.
+Must not be called concurrently with stop_tracing() or itself.
+*/
+inline void start_tracing(const std::size_t events_per_thread = 1 << 16)
+{
+    auto& session = detail::get_trace_session();
+
+    {
+        const auto lock = std::lock_guard<std::mutex>{session.mutex};
+        session.buffers.clear();
+        session.events_per_thread = events_per_thread;
+    }
+
+    session.start_time.store(detail::trace_clock_now(), std::memory_order_relaxed);
+    session.id.fetch_add(1, std::memory_order_release);
+    session.enabled.store(true, std::memory_order_release);
+}
+
+//Stop recording. The recorded events are kept.
+inline void stop_tracing()
+{
+    detail::get_trace_session().enabled.store(false, std::memory_order_release);
+}
+
+/*
+Write the recorded events as a Chrome trace (JSON Object Format).
+Threads are identified by their order of first emission since start_tracing().
+Can be called while recording.
+*/
+inline void write_chrome_trace(std::ostream& out)
+{
+    auto& session = detail::get_trace_session();
+
+    auto buffers = std::vector<std::shared_ptr<detail::trace_buffer>>{};
+    {
+        const auto lock = std::lock_guard<std::mutex>{session.mutex};
+        buffers = session.buffers;
+    }
+
+    auto dropped_event_count = std::size_t{0};
+    auto first = true;
+
+    out << "{\"traceEvents\":[";
+    for(const auto& pbuffer: buffers)
+    {
+        const auto size = pbuffer->size.load(std::memory_order_acquire);
+        for(auto i = std::size_t{0}; i < size; ++i)
+        {
+            const auto& e = pbuffer->events[i];
+
+            out << (first ? "\n" : ",\n");
+            first = false;
+
+            out << "{\"name\":";
+            detail::write_json_string(out, e.name);
+            out << ",\"cat\":\"" << e.category << '"';
+            out << ",\"ph\":\"" << e.phase << '"';
+
+            out << ",\"ts\":";
+            detail::write_trace_timestamp(out, e.timestamp);
+
+            out << ",\"pid\":0,\"tid\":" << pbuffer->thread_index;
+            out << ",\"args\":{\"depth\":" << e.depth << "}}";
+        }
+
+        dropped_event_count += pbuffer->dropped_event_count.load(std::memory_order_relaxed);
+    }
+    out << "\n],\"otherData\":{\"dropped_events\":" << dropped_event_count << "}}\n";
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,406 @@
+//Copyright Florian Goujeon 2018 - 2019.
+//Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at
+//https://www.boost.org/LICENSE_1_0.txt)
+//Official repository: https://github.com/fgoujeon/signal
+
+#ifndef FGSIG_TRACKABLE_HPP
+#define FGSIG_TRACKABLE_HPP
+
+#include "connection.hpp"
+#include "detail/raw_closure.hpp"
+#include "detail/raw_closure_id_set.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace fgsig
+{
+
+namespace detail
+{
+    struct tracked_subscription_pool;
+
+    //Node of the intrusive list of subscriptions of a trackable object
+    struct tracked_subscription_node
+    {
+        //Close the subscription and destroy the node.
+        //Doesn't unlink the node.
+        void (*close_and_destroy)(tracked_subscription_node*);
+
+        //Pool that holds the node
+        tracked_subscription_pool* ppool;
+
+        tracked_subscription_node* pnext = nullptr;
+
+        //Pointer to the pointer that points to this node
+        tracked_subscription_node** ppself = nullptr;
+
+        void unlink()
+        {
+            *ppself = pnext;
+            if(pnext)
+                pnext->ppself = ppself;
+        }
+    };
+
+    /*
+    tracked_subscription_pool holds the subscriptions of a trackable object, so
+    that connecting the object doesn't allocate one memory block per
+    subscription.
+    Subscriptions are carved out of blocks of increasing size. The memory of a
+    closed subscription goes to a free list of its size, for the next
+    subscription of the same size.
+    The pool is allocated along with its first block at the first subscription.
+    */
+    struct tracked_subscription_pool
+    {
+        public:
+            tracked_subscription_pool() = default;
+
+            tracked_subscription_pool(const tracked_subscription_pool&) = delete;
+
+            tracked_subscription_pool& operator=(const tracked_subscription_pool&) = delete;
+
+            ~tracked_subscription_pool()
+            {
+                while(pblocks_)
+                {
+                    const auto pblock = pblocks_;
+                    pblocks_ = pblock->pnext;
+                    ::operator delete(pblock);
+                }
+            }
+
+            void link(tracked_subscription_node& node)
+            {
+                node.ppool = this;
+                node.pnext = phead_;
+                node.ppself = &phead_;
+                if(phead_)
+                    phead_->ppself = &node.pnext;
+                phead_ = &node;
+            }
+
+            //Close all the subscriptions.
+            void close_all()
+            {
+                while(phead_)
+                {
+                    auto pnode = phead_;
+                    phead_ = pnode->pnext;
+                    if(phead_)
+                        phead_->ppself = &phead_;
+                    pnode->close_and_destroy(pnode);
+                }
+            }
+
+            std::size_t subscription_count() const
+            {
+                auto count = std::size_t{0};
+                for(auto pnode = phead_; pnode; pnode = pnode->pnext)
+                    ++count;
+                return count;
+            }
+
+            template<typename T>
+            void* allocate()
+            {
+                static_assert(alignof(T) <= granularity);
+
+                if constexpr(sizeof(T) > max_cell_size)
+                {
+                    large_cell_memory_usage_ += sizeof(T);
+                    return ::operator new(sizeof(T));
+                }
+                else
+                {
+                    auto& pfree_cell = free_cells_[size_class<T>()];
+                    if(pfree_cell)
+                    {
+                        const auto pcell = pfree_cell;
+                        pfree_cell = pcell->pnext;
+                        return pcell;
+                    }
+
+                    constexpr auto size = cell_size<T>();
+                    if(static_cast<std::size_t>(pfree_end_ - pfree_begin_) < size)
+                        add_block();
+
+                    const auto pcell = pfree_begin_;
+                    pfree_begin_ += size;
+                    return pcell;
+                }
+            }
+
+            template<typename T>
+            void deallocate(void* const pcell)
+            {
+                if constexpr(sizeof(T) > max_cell_size)
+                {
+                    large_cell_memory_usage_ -= sizeof(T);
+                    ::operator delete(pcell);
+                }
+                else
+                {
+                    auto& pfree_cell = free_cells_[size_class<T>()];
+                    pfree_cell = new(pcell) free_cell{pfree_cell};
+                }
+            }
+
+            //Size of dynamically allocated memory, in bytes, including the
+            //pool itself
+            std::size_t memory_usage() const
+            {
+                auto usage = sizeof(*this) + large_cell_memory_usage_;
+                for(auto pblock = pblocks_; pblock; pblock = pblock->pnext)
+                    usage += sizeof(block) + pblock->size;
+                return usage;
+            }
+
+        private:
+            struct free_cell
+            {
+                free_cell* pnext;
+            };
+
+            struct block
+            {
+                block* pnext;
+                std::size_t size;
+            };
+
+            static constexpr std::size_t granularity = alignof(void*);
+            static constexpr std::size_t size_class_count = 16;
+            static constexpr std::size_t max_cell_size = granularity * size_class_count;
+            static constexpr std::size_t max_block_size = 4096;
+
+            template<typename T>
+            static constexpr std::size_t size_class()
+            {
+                return (sizeof(T) - 1) / granularity;
+            }
+
+            template<typename T>
+            static constexpr std::size_t cell_size()
+            {
+                return (size_class<T>() + 1) * granularity;
+            }
+
+            //Allocate a block twice as large as the previous one, and drop
+            //what's left of the previous one.
+            void add_block()
+            {
+                const auto size = next_block_size_;
+                if(next_block_size_ < max_block_size)
+                    next_block_size_ *= 2;
+
+                const auto pblock = new(::operator new(sizeof(block) + size)) block{pblocks_, size};
+                pblocks_ = pblock;
+                pfree_begin_ = reinterpret_cast<unsigned char*>(pblock + 1);
+                pfree_end_ = pfree_begin_ + size;
+            }
+
+        private:
+            tracked_subscription_node* phead_ = nullptr;
+            block* pblocks_ = nullptr;
+            unsigned char* pfree_begin_ = initial_block_;
+            unsigned char* pfree_end_ = initial_block_ + sizeof(initial_block_);
+            std::size_t next_block_size_ = 512;
+            std::size_t large_cell_memory_usage_ = 0;
+            free_cell* free_cells_[size_class_count] = {};
+            alignas(void*) unsigned char initial_block_[256];
+    };
+
+    template
+    <
+        typename Signal,
+        typename Slot,
+        typename SignatureList = signal_signature_list_t<Signal>
+    >
+    struct tracked_subscription;
+}
+
+/*
+trackable is a base class for slot objects.
+Connecting a trackable object to a signal with fgsig::connect() doesn't return
+any connection object: the connection is closed when either the trackable object
+or the signal is destroyed.
+Copying a trackable object doesn't copy its connections.
+*/
+struct trackable
+{
+    private:
+        template<typename Signal, typename Slot, typename SignatureList>
+        friend struct detail::tracked_subscription;
+
+    public:
+        trackable() = default;
+
+        trackable(const trackable&)
+        {
+        }
+
+        trackable& operator=(const trackable&)
+        {
+            return *this;
+        }
+
+        ~trackable()
+        {
+            close_subscriptions();
+        }
+
+        //Close all the connections of the object.
+        //Keep their memory for the next connections.
+        void close_subscriptions()
+        {
+            if(ppool_)
+                ppool_->close_all();
+        }
+
+        //Number of open connections
+        std::size_t subscription_count() const
+        {
+            return ppool_ ? ppool_->subscription_count() : 0;
+        }
+
+        /*
+        Approximate number of bytes used by the object and its connections,
+        including dynamically allocated memory.
+        Allocator overhead isn't taken into account.
+        */
+        std::size_t memory_usage() const
+        {
+            return sizeof(*this) + (ppool_ ? ppool_->memory_usage() : 0);
+        }
+
+    private:
+        detail::tracked_subscription_pool& get_pool()
+        {
+            if(!ppool_)
+                ppool_ = std::make_unique<detail::tracked_subscription_pool>();
+            return *ppool_;
+        }
+
+    private:
+        std::unique_ptr<detail::tracked_subscription_pool> ppool_;
+};
+
+namespace detail
+{
+    /*
+    tracked_subscription holds the connection between a signal and a trackable
+    object.
+    It's created by track() in the pool of the trackable object, and destroyed
+    when the connection is closed.
+    */
+    template
+    <
+        template<typename...> typename SignalTpl,
+        typename... SignalSignatures,
+        typename Slot,
+        typename... Signatures
+    >
+    struct tracked_subscription<SignalTpl<SignalSignatures...>, Slot, signature_list<Signatures...>>:
+        tracked_subscription_node
+    {
+        static_assert(sizeof...(Signatures) != 0, "The slot can't be called with any signature of the signal.");
+
+        static_assert
+        (
+            (is_slot_invocable<Slot, function_signature_t<Signatures>>::value && ...),
+            "The slot can't be called with all the signatures it's connected to. Give fgsig::invocable_signatures to fgsig::connect() to only connect it to the signatures it can be called with."
+        );
+
+        private:
+            using signal = SignalTpl<SignalSignatures...>;
+
+        public:
+            tracked_subscription(signal& sig, slot_object_t<Slot>& slot):
+                tracked_subscription_node{&close_and_destroy_impl, nullptr},
+                psignal_(&sig),
+                event_closure_ids_
+                (
+                    psignal_->add_raw_event_closure
+                    (
+                        &slot_caller<Slot, function_signature_t<Signatures>>::call,
+                        &slot
+                    )...
+                ),
+                disconnection_closure_id_
+                (
+                    psignal_->add_raw_disconnection_closure
+                    (
+                        &on_disconnection,
+                        static_cast<tracked_subscription_node*>(this)
+                    )
+                )
+            {
+            }
+
+            static void create(signal& sig, slot_object_t<Slot>& slot)
+            {
+                trackable& owner = slot;
+                auto& pool = owner.get_pool();
+                const auto pcell = pool.allocate<tracked_subscription>();
+                try
+                {
+                    pool.link(*new(pcell) tracked_subscription{sig, slot});
+                }
+                catch(...)
+                {
+                    pool.deallocate<tracked_subscription>(pcell);
+                    throw;
+                }
+            }
+
+        private:
+            static void destroy(tracked_subscription* const pself)
+            {
+                const auto ppool = pself->ppool;
+                pself->~tracked_subscription();
+                ppool->deallocate<tracked_subscription>(pself);
+            }
+
+            static void close_and_destroy_impl(tracked_subscription_node* pnode)
+            {
+                auto pself = static_cast<tracked_subscription*>(pnode);
+                auto& sig = *pself->psignal_;
+
+                sig.remove_raw_disconnection_closure(pself->disconnection_closure_id_);
+                (
+                    sig.remove_raw_event_closure
+                    (
+                        pself->event_closure_ids_.template get<Signatures>()
+                    ),
+                    ...
+                );
+
+                destroy(pself);
+            }
+
+            static void on_disconnection(void* pvnode)
+            {
+                auto pnode = reinterpret_cast<tracked_subscription_node*>(pvnode);
+                pnode->unlink();
+                destroy(static_cast<tracked_subscription*>(pnode));
+            }
+
+        private:
+            signal* psignal_;
+            raw_closure_id_set<Signatures...> event_closure_ids_;
+            raw_closure_id<destruction_signature> disconnection_closure_id_;
+    };
+
+    //Connect the given signal to the given trackable object.
+    template<typename Signal, typename Slot, typename SignatureList>
+    void track(Signal& sig, slot_object_t<Slot>& slot)
+    {
+        tracked_subscription<Signal, Slot, SignatureList>::create(sig, slot);
+    }
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,71 @@
+//Replacements of the global operator new and delete that count the calls.
+//See utility/allocation_counter.hpp.
+
+#include "utility/allocation_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace utility
+{
+
+std::atomic<std::size_t> global_allocation_count{0};
+std::atomic<std::size_t> global_deallocation_count{0};
+
+} //namespace
+
+namespace
+{
+
+void* allocate(std::size_t size)
+{
+    utility::global_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    if(size == 0)
+        size = 1;
+
+    if(auto ptr = std::malloc(size))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void deallocate(void* ptr) noexcept
+{
+    if(ptr)
+    {
+        utility::global_deallocation_count.fetch_add(1, std::memory_order_relaxed);
+        std::free(ptr);
+    }
+}
+
+} //namespace
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
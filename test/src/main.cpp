@@ -1,12 +1,35 @@
+#include "tests/allocations.hpp"
+#include "tests/async_connection.hpp"
 #include "tests/basic.hpp"
 #include "tests/basic_example.hpp"
+#include "tests/block.hpp"
+#include "tests/capacity.hpp"
+#include "tests/coalescing_signal.hpp"
+#include "tests/combiner.hpp"
+#include "tests/connect_many.hpp"
+#include "tests/disconnect_all.hpp"
 #include "tests/disconnect_at_emit.hpp"
+#include "tests/dispatcher.hpp"
+#include "tests/emission_recorder.hpp"
+#include "tests/emit_lazy.hpp"
+#include "tests/event_bus.hpp"
 #include "tests/full_example.hpp"
+#include "tests/grouped.hpp"
+#include "tests/inline_slot.hpp"
+#include "tests/ipc_signal.hpp"
+#include "tests/method_slot.hpp"
 #include "tests/move.hpp"
 #include "tests/move_connection.hpp"
 #include "tests/multi_signature_example.hpp"
+#include "tests/non_reentrant.hpp"
+#include "tests/partial_subscription.hpp"
 #include "tests/signal_destroyed_before_slot.hpp"
+#include "tests/signal_array.hpp"
+#include "tests/signal_view.hpp"
+#include "tests/trackable.hpp"
+#include "tests/tracing.hpp"
 #include <iostream>
+#include <string>
 
 template<class TestFn>
 bool run_test(TestFn f, const char* test_name)
@@ -20,8 +43,13 @@ bool run_test(TestFn f, const char* test_name)
     return success;
 }
 
-int main()
+int main(int argc, char** argv)
 {
+#ifdef __linux__
+    if(argc == 4 && std::string{argv[1]} == tests::ipc_signal::child_process_arg)
+        return tests::ipc_signal::run_child(argv[2], argv[3]);
+#endif
+
     auto test_count = 0;
     auto success_count = 0;
 
@@ -33,14 +61,38 @@ int main()
         ++test_count; \
     }
 
+    RUN_TEST(allocations);
+    RUN_TEST(async_connection);
     RUN_TEST(basic);
     RUN_TEST(basic_example);
+    RUN_TEST(block);
+    RUN_TEST(capacity);
+    RUN_TEST(coalescing_signal);
+    RUN_TEST(combiner);
+    RUN_TEST(connect_many);
+    RUN_TEST(disconnect_all);
     RUN_TEST(disconnect_at_emit);
+    RUN_TEST(dispatcher);
+    RUN_TEST(emission_recorder);
+    RUN_TEST(emit_lazy);
+    RUN_TEST(event_bus);
     RUN_TEST(full_example);
+    RUN_TEST(grouped);
+    RUN_TEST(inline_slot);
+#ifdef __linux__
+    RUN_TEST(ipc_signal);
+#endif
+    RUN_TEST(method_slot);
     RUN_TEST(move);
     RUN_TEST(move_connection);
     RUN_TEST(multi_signature_example);
+    RUN_TEST(non_reentrant);
+    RUN_TEST(partial_subscription);
     RUN_TEST(signal_destroyed_before_slot);
+    RUN_TEST(signal_array);
+    RUN_TEST(signal_view);
+    RUN_TEST(trackable);
+    RUN_TEST(tracing);
 
     std::cout << "\n" << success_count << "/" << test_count << " tests succeeded.\n";
     if(success_count == test_count)
@@ -0,0 +1,168 @@
+#ifndef TESTS_ALLOCATIONS_HPP
+#define TESTS_ALLOCATIONS_HPP
+
+//Check the exact number of dynamic allocations and deallocations done by each
+//operation.
+
+#include "../utility/allocation_counter.hpp"
+#include <fgsig.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace tests::allocations
+{
+
+using signal = fgsig::signal
+<
+    void(int),
+    void(const std::string&)
+>;
+
+//Number of closures per connection: one per signature and one for the
+//destruction of the signal.
+constexpr auto closure_count = 3;
+
+struct slot
+{
+    template<typename T>
+    void operator()(const T&)
+    {
+        ++call_count;
+    }
+
+    int call_count = 0;
+};
+
+bool test()
+{
+    using utility::allocation_counter;
+
+    auto ok = true;
+
+    auto psig = std::make_unique<signal>();
+    auto& sig = *psig;
+    const auto str = std::string{"a"};
+    auto slot0 = slot{};
+
+    //emit without any slot
+    {
+        const auto counter = allocation_counter{};
+        sig.emit(1);
+        sig.emit(str);
+        ok = ok && counter.check(0, 0);
+    }
+
+    //first connect (allocates the state of the signal)
+    auto connection0 = std::optional<signal::connection<slot>>{};
+    {
+        const auto counter = allocation_counter{};
+        connection0.emplace(sig, slot0);
+        ok = ok && counter.check(closure_count + 1, 0);
+    }
+
+    //emit
+    {
+        const auto counter = allocation_counter{};
+        sig.emit(1);
+        sig.emit(str);
+        ok = ok && counter.check(0, 0);
+        ok = ok && slot0.call_count == 2;
+    }
+
+    //move connection
+    auto connection0b = std::optional<signal::connection<slot>>{};
+    {
+        const auto counter = allocation_counter{};
+        connection0b.emplace(std::move(*connection0));
+        ok = ok && counter.check(0, 0);
+    }
+
+    //connect with ownership
+    auto connection1 = std::optional<signal::owning_connection<slot>>{};
+    {
+        const auto counter = allocation_counter{};
+        connection1.emplace(sig, slot{});
+        ok = ok && counter.check(closure_count, 0);
+    }
+
+    //move owning connection
+    auto connection1b = std::optional<signal::owning_connection<slot>>{};
+    {
+        const auto counter = allocation_counter{};
+        connection1b.emplace(std::move(*connection1));
+        ok = ok && counter.check(0, 0);
+    }
+
+    //emit with two slots
+    {
+        const auto counter = allocation_counter{};
+        sig.emit(1);
+        ok = ok && counter.check(0, 0);
+    }
+
+    //close
+    {
+        const auto counter = allocation_counter{};
+        connection1b->close();
+        ok = ok && counter.check(0, closure_count);
+    }
+
+    //destroy closed and moved-from connections
+    {
+        const auto counter = allocation_counter{};
+        connection0.reset();
+        connection1.reset();
+        connection1b.reset();
+        ok = ok && counter.check(0, 0);
+    }
+
+    //close during emit
+    {
+        auto connection2 = std::optional<signal::connection<slot>>{};
+        auto slot2 = slot{};
+        auto closing_slot = [&connection2](const auto&)
+        {
+            connection2.reset();
+        };
+        auto connection3 = fgsig::connect(sig, closing_slot);
+        connection2.emplace(sig, slot2);
+
+        const auto counter = allocation_counter{};
+        sig.emit(1);
+        ok = ok && counter.check(0, closure_count);
+    }
+
+    //connect and close within reserved capacity
+    {
+        sig.reserve(2);
+
+        const auto counter = allocation_counter{};
+        {
+            auto connection = fgsig::connect(sig, slot0);
+        }
+        ok = ok && counter.check(0, 0);
+
+        sig.shrink_to_fit();
+    }
+
+    //destroy signal
+    {
+        const auto counter = allocation_counter{};
+        psig.reset();
+        ok = ok && counter.check(0, closure_count + 2);
+    }
+
+    //destroy connection after signal
+    {
+        const auto counter = allocation_counter{};
+        connection0b.reset();
+        ok = ok && counter.check(0, 0);
+    }
+
+    return ok;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef TESTS_ASYNC_CONNECTION_HPP
+#define TESTS_ASYNC_CONNECTION_HPP
+
+#include <fgsig.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tests::async_connection
+{
+
+using signal = fgsig::signal<void(int), void(const std::string&)>;
+
+//Executor whose tasks are run by an explicit call to run()
+struct manual_executor
+{
+    void post(std::function<void()> task)
+    {
+        tasks.push_back(std::move(task));
+    }
+
+    void run()
+    {
+        //Tasks may post other tasks.
+        for(auto i = std::size_t{0}; i < tasks.size(); ++i)
+            tasks[i]();
+        tasks.clear();
+    }
+
+    std::vector<std::function<void()>> tasks;
+};
+
+bool test_order()
+{
+    constexpr auto emission_count = 1000;
+
+    auto ok = true;
+    auto pool = fgsig::thread_pool{4};
+    signal sig;
+
+    auto values = std::vector<int>{};
+    auto done = std::promise<void>{};
+    auto slot = [&](const auto& value)
+    {
+        if constexpr(std::is_same_v<std::decay_t<decltype(value)>, int>)
+        {
+            values.push_back(value);
+            if(value == emission_count - 1)
+                done.set_value();
+        }
+    };
+    auto c = fgsig::connect(sig, slot, pool);
+
+    for(auto i = 0; i < emission_count; ++i)
+        sig.emit(i);
+    done.get_future().wait();
+
+    for(auto i = 0; i < emission_count; ++i)
+        ok = ok && values[i] == i;
+
+    return ok;
+}
+
+bool test_strand()
+{
+    constexpr auto task_count = 1000;
+
+    auto ok = true;
+    auto pool = fgsig::thread_pool{4};
+    auto strand = fgsig::strand<fgsig::thread_pool>{pool};
+
+    auto values = std::vector<int>{};
+    auto done = std::promise<void>{};
+    for(auto i = 0; i < task_count; ++i)
+    {
+        strand.post
+        (
+            [&, i]
+            {
+                values.push_back(i);
+                if(i == task_count - 1)
+                    done.set_value();
+            }
+        );
+    }
+    done.get_future().wait();
+
+    for(auto i = 0; i < task_count; ++i)
+        ok = ok && values[i] == i;
+
+    return ok;
+}
+
+bool test_argument_copy()
+{
+    auto ok = true;
+    auto executor = manual_executor{};
+    signal sig;
+
+    auto received = std::string{};
+    auto slot = [&received](const auto& value)
+    {
+        if constexpr(std::is_same_v<std::decay_t<decltype(value)>, std::string>)
+            received += value;
+    };
+    auto c = fgsig::connect(sig, slot, executor);
+
+    {
+        auto str = std::string{"abc"};
+        sig.emit(str);
+        str = "def";
+        sig.emit(str);
+    }
+    ok = ok && received.empty();
+
+    executor.run();
+    ok = ok && received == "abcdef";
+
+    return ok;
+}
+
+bool test_close_discards_pending_calls()
+{
+    auto ok = true;
+    auto executor = manual_executor{};
+    signal sig;
+
+    auto call_count = 0;
+    {
+        //owned slot
+        auto c = fgsig::connect(sig, [&call_count](const auto&){++call_count;}, executor);
+        sig.emit(0);
+        sig.emit("a");
+        c.close();
+        sig.emit(1);
+        ok = ok && sig.empty();
+    }
+
+    executor.run();
+    ok = ok && call_count == 0;
+
+    return ok;
+}
+
+bool test_close_waits_for_running_call()
+{
+    auto ok = true;
+    auto pool = fgsig::thread_pool{1};
+    signal sig;
+
+    auto started = std::promise<void>{};
+    auto finished = std::atomic<bool>{false};
+    auto call_count = std::atomic<int>{0};
+    auto slot = [&](const auto&)
+    {
+        if(call_count++ == 0)
+        {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+            finished = true;
+        }
+    };
+    auto c = fgsig::connect(sig, slot, pool);
+
+    sig.emit(0);
+    sig.emit(1);
+    started.get_future().wait();
+    c.close();
+
+    ok = ok && finished;
+    ok = ok && call_count == 1;
+
+    return ok;
+}
+
+//The slot must live until the call that destroyed its connection returns.
+struct self_destroying_slot
+{
+    using connection = fgsig::async_connection<signal, self_destroying_slot, manual_executor>;
+
+    template<typename T>
+    void operator()(const T&)
+    {
+        pconnection->reset();
+        *preceived = value;
+    }
+
+    std::optional<connection>* pconnection;
+    std::string* preceived;
+    std::string value;
+};
+
+bool test_destroy_from_slot()
+{
+    auto executor = manual_executor{};
+    signal sig;
+
+    auto c = std::optional<self_destroying_slot::connection>{};
+    auto received = std::string{};
+    c.emplace(sig, self_destroying_slot{&c, &received, std::string(64, 'x')}, executor);
+
+    sig.emit(0);
+    sig.emit(1);
+    executor.run();
+
+    return !c && received == std::string(64, 'x') && sig.empty();
+}
+
+//Executor that catches the exceptions of its tasks
+struct catching_executor
+{
+    void post(std::function<void()> task)
+    {
+        tasks.push_back(std::move(task));
+    }
+
+    void run()
+    {
+        for(auto i = std::size_t{0}; i < tasks.size(); ++i)
+        {
+            try
+            {
+                tasks[i]();
+            }
+            catch(const std::runtime_error&)
+            {
+                ++exception_count;
+            }
+        }
+        tasks.clear();
+    }
+
+    std::vector<std::function<void()>> tasks;
+    int exception_count = 0;
+};
+
+//A throwing call doesn't keep the next ones from being made, nor close() from
+//returning.
+bool test_throwing_slot()
+{
+    auto ok = true;
+    auto executor = catching_executor{};
+    signal sig;
+
+    auto call_count = 0;
+    auto slot = [&call_count](const auto&)
+    {
+        if(call_count++ == 0)
+            throw std::runtime_error{"error"};
+    };
+    auto c = fgsig::connect(sig, slot, executor);
+
+    sig.emit(0);
+    sig.emit(1);
+    sig.emit(2);
+    executor.run();
+    ok = ok && call_count == 3;
+    ok = ok && executor.exception_count == 1;
+
+    sig.emit(3);
+    executor.run();
+    ok = ok && call_count == 4;
+
+    //close from another thread (the future would wait forever on failure)
+    if(ok)
+    {
+        auto closed = std::async(std::launch::async, [&c]{c.close();});
+        ok = closed.wait_for(std::chrono::seconds{5}) == std::future_status::ready;
+    }
+
+    return ok;
+}
+
+bool test()
+{
+    auto ok = true;
+    ok = ok && test_order();
+    ok = ok && test_strand();
+    ok = ok && test_argument_copy();
+    ok = ok && test_close_discards_pending_calls();
+    ok = ok && test_close_waits_for_running_call();
+    ok = ok && test_destroy_from_slot();
+    ok = ok && test_throwing_slot();
+    return ok;
+}
+
+} //namespace
+
+#endif
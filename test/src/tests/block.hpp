@@ -0,0 +1,118 @@
+#ifndef TESTS_BLOCK_HPP
+#define TESTS_BLOCK_HPP
+
+#include "../utility/allocation_counter.hpp"
+#include <fgsig.hpp>
+#include <sstream>
+#include <string>
+
+namespace tests::block
+{
+
+using signal = fgsig::signal
+<
+    void(int),
+    fgsig::combined<int(const std::string&), fgsig::sum<int>>
+>;
+
+struct slot
+{
+    void operator()(const int value)
+    {
+        oss << id << value;
+    }
+
+    int operator()(const std::string&)
+    {
+        return 1;
+    }
+
+    std::ostringstream& oss;
+    int id;
+};
+
+bool test()
+{
+    auto ok = true;
+    std::ostringstream oss;
+    signal sig;
+
+    auto slot0 = slot{oss, 0};
+    auto connection0 = fgsig::connect(sig, slot0);
+    auto connection1 = fgsig::connect(sig, slot{oss, 1});
+
+    {
+        const auto counter = utility::allocation_counter{};
+        connection0.block();
+        ok = ok && counter.check(0, 0);
+    }
+    ok = ok && connection0.blocked();
+
+    sig.emit(1);
+    ok = ok && sig.emit("a") == 1;
+
+    {
+        auto block0 = fgsig::shared_block{connection0};
+        auto block1 = fgsig::shared_block{connection1};
+        auto block1b = fgsig::shared_block{connection1};
+        sig.emit(2);
+        ok = ok && sig.emit("a") == 0;
+    }
+    ok = ok && connection0.blocked();
+    ok = ok && !connection1.blocked();
+
+    //blocked state follows moves
+    auto connection1b = std::move(connection1);
+    connection1b.block();
+    sig.emit(3);
+    auto connection1c = std::move(connection1b);
+    ok = ok && connection1c.blocked();
+    sig.emit(4);
+    connection1c.unblock();
+
+    {
+        const auto counter = utility::allocation_counter{};
+        connection0.unblock();
+        ok = ok && counter.check(0, 0);
+    }
+    sig.emit(5);
+    ok = ok && sig.emit("a") == 2;
+
+    //block during emit
+    {
+        struct blocking_slot
+        {
+            void operator()(int)
+            {
+                connection.block();
+            }
+
+            int operator()(const std::string&)
+            {
+                return 0;
+            }
+
+            fgsig::connection<signal, slot>& connection;
+        };
+
+        auto slot2 = blocking_slot{connection0};
+        auto connection2 = fgsig::connect(sig, slot2);
+        sig.emit(6);
+        sig.emit(7);
+        connection0.unblock();
+    }
+
+    const auto expected_str =
+        "11"
+        "0515"
+        "06"
+        "16"
+        "17"
+    ;
+
+    return ok && oss.str() == expected_str;
+}
+
+} //namespace
+
+#endif
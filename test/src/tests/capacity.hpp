@@ -0,0 +1,73 @@
+#ifndef TESTS_CAPACITY_HPP
+#define TESTS_CAPACITY_HPP
+
+#include <fgsig.hpp>
+#include <optional>
+#include <string>
+
+namespace tests::capacity
+{
+
+using signal = fgsig::signal
+<
+    void(int),
+    void(const std::string&)
+>;
+
+bool test()
+{
+    auto ok = true;
+
+    signal sig;
+    ok = ok && sig.empty();
+    ok = ok && sig.slot_count<void(int)>() == 0;
+
+    //an unconnected signal only holds a null pointer
+    const auto empty_memory_usage = sig.memory_usage();
+    ok = ok && empty_memory_usage == sizeof(signal);
+    ok = ok && sizeof(signal) == sizeof(void*);
+
+    sig.reserve(4);
+    const auto reserved_memory_usage = sig.memory_usage();
+    ok = ok && reserved_memory_usage > empty_memory_usage;
+
+    {
+        auto slot = [](const auto&){};
+        auto connection0 = fgsig::connect(sig, slot);
+        auto connection1 = fgsig::connect(sig, slot);
+        ok = ok && !sig.empty();
+        ok = ok && sig.slot_count<void(int)>() == 2;
+        ok = ok && sig.slot_count<void(const std::string&)>() == 2;
+
+        //connecting within reserved capacity doesn't use more memory
+        ok = ok && sig.memory_usage() == reserved_memory_usage;
+
+        //slots whose connection is closed during emit() aren't counted
+        auto count_during_emit = std::size_t{0};
+        auto connection2 = std::optional<signal::connection<decltype(slot)>>{};
+        auto closing_slot = [&](const auto&)
+        {
+            connection2.reset();
+            count_during_emit = sig.slot_count<void(int)>();
+        };
+        auto connection3 = fgsig::connect(sig, closing_slot);
+        connection2.emplace(sig, slot);
+        sig.emit(0);
+        ok = ok && count_during_emit == 3;
+        ok = ok && sig.slot_count<void(int)>() == 3;
+    }
+
+    //disconnecting keeps the reserved memory
+    ok = ok && sig.empty();
+    ok = ok && sig.memory_usage() == reserved_memory_usage;
+
+    //shrinking an unconnected signal frees its whole state
+    sig.shrink_to_fit();
+    ok = ok && sig.memory_usage() == empty_memory_usage;
+
+    return ok;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef TESTS_COALESCING_SIGNAL_HPP
+#define TESTS_COALESCING_SIGNAL_HPP
+
+#include <fgsig.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace tests::coalescing_signal
+{
+
+using signal = fgsig::coalescing_signal
+<
+    void(int),
+    void(const std::string&),
+    void(std::unique_ptr<int>&&)
+>;
+
+bool test()
+{
+    std::ostringstream oss;
+    signal sig;
+
+    auto connection = fgsig::connect
+    (
+        sig,
+        [&oss](const auto& value)
+        {
+            if constexpr(std::is_same_v<std::decay_t<decltype(value)>, std::unique_ptr<int>>)
+                oss << "p" << *value;
+            else
+                oss << value;
+            oss << ';';
+        }
+    );
+
+    //nothing is delivered before flush()
+    sig.emit("a");
+    sig.emit(1);
+    sig.emit(2);
+    sig.emit("b");
+    sig.emit(std::make_unique<int>(7));
+    sig.emit(3);
+    const auto ok0 = oss.str().empty();
+
+    //latest value of each signature, in signature order
+    sig.flush();
+
+    //nothing pending anymore
+    sig.flush();
+
+    sig.emit(4);
+    sig.flush();
+
+    const auto expected_str =
+        "3;"
+        "b;"
+        "p7;"
+        "4;"
+    ;
+
+    return ok0 && oss.str() == expected_str;
+}
+
+} //namespace
+
+#endif
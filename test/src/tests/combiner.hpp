@@ -0,0 +1,142 @@
+#ifndef TESTS_COMBINER_HPP
+#define TESTS_COMBINER_HPP
+
+#include <fgsig.hpp>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace tests::combiner
+{
+
+struct query{};
+struct request{};
+struct lookup{};
+
+using signal = fgsig::signal
+<
+    void(int),
+    fgsig::combined<int(int, int), fgsig::sum<int>>,
+    fgsig::combined<int(const query&), fgsig::maximum<int>>,
+    fgsig::combined<bool(const request&), fgsig::all_of>,
+    fgsig::combined<std::optional<std::string>(const lookup&), fgsig::first_non_empty<std::string>>
+>;
+
+//custom combiner: number of slots that have been called
+struct counter
+{
+    bool operator()(bool)
+    {
+        ++count;
+        return true;
+    }
+
+    int result() const
+    {
+        return count;
+    }
+
+    int count = 0;
+};
+
+bool test()
+{
+    auto ok = true;
+
+    signal sig;
+
+    //no slot
+    ok = ok && sig.emit(1, 2) == 0;
+    ok = ok && !sig.emit(query{});
+    ok = ok && sig.emit(request{});
+    ok = ok && !sig.emit(lookup{});
+
+    auto call_count = 0;
+
+    struct slot
+    {
+        void operator()(int)
+        {
+        }
+
+        int operator()(const int a, const int b)
+        {
+            ++call_count;
+            return (a + b) * factor;
+        }
+
+        int operator()(const query&)
+        {
+            ++call_count;
+            return factor;
+        }
+
+        bool operator()(const request&)
+        {
+            ++call_count;
+            return factor != 2;
+        }
+
+        std::optional<std::string> operator()(const lookup&)
+        {
+            ++call_count;
+            if(factor == 1)
+                return std::nullopt;
+            return std::to_string(factor);
+        }
+
+        int& call_count;
+        int factor;
+    };
+
+    auto connection1 = fgsig::connect(sig, slot{call_count, 1});
+    auto connection2 = fgsig::connect(sig, slot{call_count, 2});
+    auto connection3 = fgsig::connect(sig, slot{call_count, 3});
+
+    //sum
+    call_count = 0;
+    ok = ok && sig.emit(1, 2) == 3 + 6 + 9;
+    ok = ok && call_count == 3;
+
+    //maximum
+    call_count = 0;
+    ok = ok && sig.emit(query{}) == 3;
+    ok = ok && call_count == 3;
+
+    //all_of, stops at second slot
+    call_count = 0;
+    ok = ok && !sig.emit(request{});
+    ok = ok && call_count == 2;
+
+    //first_non_empty, stops at second slot
+    call_count = 0;
+    ok = ok && sig.emit(lookup{}) == std::string{"2"};
+    ok = ok && call_count == 2;
+
+    //closed connections are skipped even during emit
+    {
+        using closing_signal = fgsig::signal<fgsig::combined<bool(), counter>>;
+        closing_signal sig2;
+        auto connection4 = std::optional<closing_signal::connection<std::function<bool()>>>{};
+        auto slot4 = std::function<bool()>{[]{return true;}};
+        auto connection5 = fgsig::connect
+        (
+            sig2,
+            [&connection4]
+            {
+                connection4.reset();
+                return true;
+            }
+        );
+        connection4.emplace(sig2, slot4);
+
+        ok = ok && sig2.emit() == 1;
+        ok = ok && sig2.emit() == 1;
+    }
+
+    return ok;
+}
+
+} //namespace
+
+#endif
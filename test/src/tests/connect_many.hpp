@@ -0,0 +1,75 @@
+#ifndef TESTS_CONNECT_MANY_HPP
+#define TESTS_CONNECT_MANY_HPP
+
+#include <fgsig.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tests::connect_many
+{
+
+using signal = fgsig::signal
+<
+    void(int),
+    void(const std::string&)
+>;
+
+struct slot
+{
+    template<typename T>
+    void operator()(const T& value)
+    {
+        *poss << id << value;
+    }
+
+    std::ostringstream* poss;
+    int id;
+};
+
+bool test()
+{
+    auto ok = true;
+    std::ostringstream oss;
+
+    signal sig;
+
+    auto slots = std::vector<slot>{};
+    for(auto i = 0; i < 3; ++i)
+        slots.push_back(slot{&oss, i});
+
+    {
+        auto connections = fgsig::connect_many(sig, slots);
+        auto connections2 = std::move(connections);
+        ok = ok && connections2.size() == 3;
+        ok = ok && sig.slot_count<void(int)>() == 3;
+
+        sig.emit(5);
+        sig.emit("a");
+
+        //automatic disconnection
+    }
+
+    ok = ok && sig.empty();
+    sig.emit(6);
+
+    //signal destroyed before connection set
+    {
+        auto psig = std::make_unique<signal>();
+        auto connections = fgsig::connect_many(*psig, slots);
+        psig.reset();
+        ok = ok && connections.size() == 0;
+    }
+
+    const auto expected_str =
+        "051525"
+        "0a1a2a"
+    ;
+
+    return ok && oss.str() == expected_str;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef TESTS_DISCONNECT_ALL_HPP
+#define TESTS_DISCONNECT_ALL_HPP
+
+#include "../utility/allocation_counter.hpp"
+#include <fgsig.hpp>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tests::disconnect_all
+{
+
+using signal = fgsig::signal<void(int), void(const std::string&)>;
+
+struct slot
+{
+    template<typename T>
+    void operator()(const T& value)
+    {
+        oss << id << value;
+    }
+
+    std::ostringstream& oss;
+    int id;
+};
+
+struct receiver: fgsig::trackable
+{
+    template<typename T>
+    void operator()(const T& value)
+    {
+        oss << 'r' << value;
+    }
+
+    std::ostringstream& oss;
+};
+
+bool test_disconnect_all()
+{
+    auto ok = true;
+    std::ostringstream oss;
+    signal sig;
+
+    auto slot0 = slot{oss, 0};
+    auto r = receiver{{}, oss};
+    auto connection0 = std::optional<signal::connection<slot>>{};
+    connection0.emplace(sig, slot0);
+    auto connection1 = fgsig::connect(sig, slot{oss, 1});
+    fgsig::connect(sig, r);
+
+    //one signature
+    sig.disconnect_all<void(int)>();
+    ok = ok && sig.slot_count<void(int)>() == 0;
+    ok = ok && sig.slot_count<void(const std::string&)>() == 3;
+    sig.emit(1);
+    sig.emit("a");
+
+    //closing a connection whose closures have been removed only removes the
+    //remaining closures
+    connection0->block();
+    sig.emit("b");
+    connection0->unblock();
+    connection0.reset();
+    ok = ok && sig.slot_count<void(const std::string&)>() == 2;
+
+    //all signatures
+    sig.disconnect_all();
+    ok = ok && sig.empty();
+    ok = ok && r.subscription_count() == 0;
+    sig.emit(2);
+    sig.emit("c");
+
+    //closing a connection after disconnect_all() doesn't touch the signal
+    {
+        const auto counter = utility::allocation_counter{};
+        connection1.close();
+        ok = ok && counter.check(0, 0);
+    }
+
+    //the signal can be connected again
+    auto connection2 = fgsig::connect(sig, slot{oss, 2});
+    sig.emit(3);
+
+    ok = ok && oss.str() == "0a1ara1brb23";
+
+    return ok;
+}
+
+bool test_disconnect_all_at_emit()
+{
+    auto ok = true;
+    std::ostringstream oss;
+    signal sig;
+
+    sig.reserve(4);
+    const auto reserved_memory_usage = sig.memory_usage();
+
+    auto slot0 = slot{oss, 0};
+    auto slot2 = slot{oss, 2};
+    auto disconnecting_slot = [&sig](const auto&)
+    {
+        sig.disconnect_all();
+    };
+
+    {
+        auto connection0 = fgsig::connect(sig, slot0);
+        auto connection1 = fgsig::connect(sig, disconnecting_slot);
+        auto connection2 = fgsig::connect(sig, slot2);
+        sig.emit(1);
+        ok = ok && sig.empty();
+        sig.emit(2);
+    }
+
+    //the reserved memory is kept
+    ok = ok && sig.memory_usage() == reserved_memory_usage;
+
+    ok = ok && oss.str() == "01";
+
+    return ok;
+}
+
+//The connections that disconnect_all() doesn't notify must still be notified
+//of the destruction of the signal.
+bool test_signal_destroyed_after_disconnect_all()
+{
+    auto ok = true;
+    std::ostringstream oss;
+
+    auto slot0 = slot{oss, 0};
+    auto slots = std::vector<slot>{slot{oss, 1}, slot{oss, 2}};
+    auto connection0 = std::optional<signal::connection<slot>>{};
+    auto connection1 = std::optional<signal::connection<slot>>{};
+    auto connections = std::optional<signal::connection_set<slot>>{};
+
+    {
+        signal sig;
+        connection0.emplace(sig, slot0);
+        connection1.emplace(sig, slot0);
+        connections.emplace(sig, slots);
+        sig.disconnect_all();
+        ok = ok && connections->size() == 0;
+
+        //close and move detached connections
+        connection0.reset();
+        auto connection1b = std::move(*connection1);
+        connection1.emplace(std::move(connection1b));
+
+        //disconnect again
+        auto connection2 = fgsig::connect(sig, slot{oss, 3});
+        sig.disconnect_all();
+        connection2.close();
+        sig.shrink_to_fit();
+
+        sig.emit(0);
+    }
+
+    connection1->close();
+
+    ok = ok && oss.str().empty();
+
+    return ok;
+}
+
+bool test()
+{
+    auto ok = true;
+    ok = ok && test_disconnect_all();
+    ok = ok && test_disconnect_all_at_emit();
+    ok = ok && test_signal_destroyed_after_disconnect_all();
+    return ok;
+}
+
+} //namespace
+
+#endif
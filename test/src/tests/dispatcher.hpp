@@ -0,0 +1,217 @@
+#ifndef TESTS_DISPATCHER_HPP
+#define TESTS_DISPATCHER_HPP
+
+#include "../utility/allocation_counter.hpp"
+#include <fgsig.hpp>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tests::dispatcher
+{
+
+using signal = fgsig::signal<void(int), void(std::string&&)>;
+
+struct receiver
+{
+    void operator()(const int value)
+    {
+        values.push_back(value);
+    }
+
+    void operator()(std::string&& str)
+    {
+        strings.push_back(std::move(str));
+    }
+
+    std::vector<int> values;
+    std::vector<std::string> strings;
+};
+
+bool test_order()
+{
+    constexpr auto signal_count = 100;
+    constexpr auto emission_count = 100;
+
+    auto ok = true;
+    auto d = fgsig::dispatcher{4};
+
+    auto sigs = std::vector<std::unique_ptr<signal>>{};
+    auto receivers = std::vector<receiver>(signal_count);
+    auto connections = std::vector<fgsig::connection<signal, receiver>>{};
+    sigs.reserve(signal_count);
+    connections.reserve(signal_count);
+    for(auto i = 0; i < signal_count; ++i)
+    {
+        sigs.push_back(std::make_unique<signal>());
+        connections.emplace_back(*sigs.back(), receivers[i]);
+    }
+
+    auto batch = fgsig::emit_batch{};
+    for(auto round = 0; round < 2; ++round)
+    {
+        //interleave the emissions of the signals
+        for(auto i = 0; i < emission_count; ++i)
+            for(auto& psig: sigs)
+                batch.add(*psig, i);
+        batch.add(*sigs[0], std::string{"end"});
+
+        d.run(batch);
+        ok = ok && batch.empty();
+    }
+
+    for(const auto& r: receivers)
+    {
+        ok = ok && r.values.size() == 2 * emission_count;
+        for(auto i = 0; i < 2 * emission_count; ++i)
+            ok = ok && r.values[i] == i % emission_count;
+    }
+    ok = ok && receivers[0].strings == std::vector<std::string>{"end", "end"};
+
+    return ok;
+}
+
+bool test_disconnect_during_emission()
+{
+    auto ok = true;
+    auto d = fgsig::dispatcher{2};
+    signal sig;
+
+    auto call_count = 0;
+    auto connection = std::optional<fgsig::owning_connection<signal, std::function<void(int)>, fgsig::signature_list<void(int)>>>{};
+    connection.emplace
+    (
+        sig,
+        [&](int)
+        {
+            ++call_count;
+            connection.reset();
+        }
+    );
+
+    auto batch = fgsig::emit_batch{};
+    batch.add(sig, 0);
+    batch.add(sig, 1);
+    d.run(batch);
+
+    ok = ok && call_count == 1;
+    ok = ok && sig.empty();
+
+    return ok;
+}
+
+bool test_exception()
+{
+    auto ok = true;
+    auto d = fgsig::dispatcher{2};
+    signal sig0;
+    signal sig1;
+
+    auto c0 = fgsig::connect(sig0, [](int){throw std::runtime_error{"error"};}, fgsig::invocable_signatures);
+    auto r = receiver{};
+    auto c1 = fgsig::connect(sig1, r);
+
+    auto batch = fgsig::emit_batch{};
+    batch.add(sig0, 0);
+    batch.add(sig1, 1);
+    batch.add(sig1, 2);
+
+    auto thrown = false;
+    try
+    {
+        d.run(batch);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    ok = ok && thrown;
+    ok = ok && r.values == std::vector<int>{1, 2};
+
+    return ok;
+}
+
+//A reused batch doesn't allocate for every emission.
+bool test_batch_reuse()
+{
+    constexpr auto signal_count = 10;
+    constexpr auto emission_count = 1000;
+
+    auto ok = true;
+    auto d = fgsig::dispatcher{2};
+
+    auto sigs = std::vector<signal>(signal_count);
+    auto sum = 0;
+    auto connections = std::vector<fgsig::owning_connection<signal, std::function<void(int)>, fgsig::signature_list<void(int)>>>{};
+    connections.reserve(signal_count);
+    for(auto& sig: sigs)
+        connections.emplace_back(sig, [&sum](const int value){sum += value;});
+
+    auto batch = fgsig::emit_batch{};
+    for(auto round = 0; round < 2; ++round)
+    {
+        const auto counter = utility::allocation_counter{};
+        for(auto i = 0; i < emission_count; ++i)
+            batch.add(sigs[i % signal_count], 1);
+
+        //The second time, only the index of the groups allocates.
+        if(round == 1)
+            ok = ok && counter.allocation_count() <= signal_count;
+
+        d.run(batch);
+    }
+
+    //Pending emissions are destroyed with the batch.
+    {
+        auto pending_batch = fgsig::emit_batch{};
+        pending_batch.add(sigs[0], 1);
+        pending_batch.add(sigs[0], std::string(64, 'x'));
+    }
+
+    ok = ok && sum == 2 * emission_count;
+
+    return ok;
+}
+
+bool test_zero_thread_count()
+{
+    auto dispatcher_thrown = false;
+    try
+    {
+        auto d = fgsig::dispatcher{0};
+    }
+    catch(const std::invalid_argument&)
+    {
+        dispatcher_thrown = true;
+    }
+
+    auto pool_thrown = false;
+    try
+    {
+        auto pool = fgsig::thread_pool{0};
+    }
+    catch(const std::invalid_argument&)
+    {
+        pool_thrown = true;
+    }
+
+    return dispatcher_thrown && pool_thrown;
+}
+
+bool test()
+{
+    auto ok = true;
+    ok = ok && test_order();
+    ok = ok && test_disconnect_during_emission();
+    ok = ok && test_exception();
+    ok = ok && test_batch_reuse();
+    ok = ok && test_zero_thread_count();
+    return ok;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef TESTS_EMISSION_RECORDER_HPP
+#define TESTS_EMISSION_RECORDER_HPP
+
+#include <fgsig.hpp>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace tests::emission_recorder
+{
+
+struct position
+{
+    int x;
+    int y;
+};
+
+using signal = fgsig::signal
+<
+    void(int),
+    void(const position&, char)
+>;
+
+bool test_replay()
+{
+    auto ok = true;
+    auto log_stream = std::stringstream{};
+
+    //record
+    {
+        signal sig;
+        sig.emit(0); //not recorded
+
+        auto recorder = fgsig::emission_recorder<signal>{sig, log_stream};
+        sig.emit(1);
+        sig.emit(position{2, 3}, 'a');
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        sig.emit(4);
+    }
+
+    //replay
+    auto log = fgsig::emission_log<signal>::read(log_stream);
+    ok = ok && log.size() == 3;
+
+    auto oss = std::ostringstream{};
+    signal sig;
+    auto connection = fgsig::connect
+    (
+        sig,
+        [&oss](const auto& value, const auto&... values)
+        {
+            if constexpr(sizeof...(values) == 0)
+                oss << value << ';';
+            else
+                ((oss << value.x << value.y) << ... << values) << ';';
+        }
+    );
+
+    log.replay(sig);
+
+    const auto start_time = std::chrono::steady_clock::now();
+    log.replay(sig, fgsig::replay_speed::recorded);
+    const auto duration = std::chrono::steady_clock::now() - start_time;
+    ok = ok && duration >= std::chrono::milliseconds{20};
+
+    ok = ok && oss.str() == "1;23a;4;1;23a;4;";
+
+    //mismatching signal type
+    {
+        auto log_stream2 = std::stringstream{log_stream.str()};
+        try
+        {
+            fgsig::emission_log<fgsig::signal<void(int)>>::read(log_stream2);
+            ok = false;
+        }
+        catch(const std::runtime_error&)
+        {
+        }
+    }
+
+    return ok;
+}
+
+/*
+Check that the emissions made by a slot during another emission aren't
+recorded, since replaying the outer emission makes them again.
+*/
+bool test_nested_emissions()
+{
+    auto log_stream = std::stringstream{};
+    auto oss = std::ostringstream{};
+
+    //Re-emit 0 and a position when receiving a positive int.
+    const auto connect_reemitting_slot = [&oss](signal& sig)
+    {
+        return fgsig::connect
+        (
+            sig,
+            [&oss, &sig](const auto& value, const auto&... values)
+            {
+                if constexpr(sizeof...(values) == 0)
+                {
+                    oss << value << ';';
+                    if(value > 0)
+                    {
+                        sig.emit(0);
+                        sig.emit(position{value, value}, 'n');
+                    }
+                }
+                else
+                {
+                    ((oss << value.x << value.y) << ... << values) << ';';
+                }
+            }
+        );
+    };
+
+    //record
+    {
+        signal sig;
+        auto connection = connect_reemitting_slot(sig);
+        auto recorder = fgsig::emission_recorder<signal>{sig, log_stream};
+        sig.emit(1);
+        sig.emit(position{2, 3}, 'a');
+    }
+
+    auto log = fgsig::emission_log<signal>::read(log_stream);
+
+    //replay
+    oss.str("");
+    signal sig;
+    auto connection = connect_reemitting_slot(sig);
+    log.replay(sig);
+
+    return
+        log.size() == 2 &&
+        oss.str() == "1;0;11n;23a;"
+    ;
+}
+
+bool test()
+{
+    auto ok = true;
+    ok = ok && test_replay();
+    ok = ok && test_nested_emissions();
+    return ok;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef TESTS_EMIT_LAZY_HPP
+#define TESTS_EMIT_LAZY_HPP
+
+#include <fgsig.hpp>
+#include <functional>
+#include <optional>
+#include <string>
+#include <tuple>
+
+namespace tests::emit_lazy
+{
+
+using signal = fgsig::signal
+<
+    void(const std::string&),
+    void(int, const std::string&),
+    fgsig::combined<int(int), fgsig::sum<int>>
+>;
+
+bool test()
+{
+    auto ok = true;
+    signal sig;
+
+    auto str = std::string{};
+    auto factory_call_count = 0;
+    auto factory = [&]
+    {
+        ++factory_call_count;
+        return std::string{"event"};
+    };
+
+    //no slot
+    sig.emit_lazy<void(const std::string&)>(factory);
+    ok = ok && factory_call_count == 0;
+    ok = ok && sig.emit_lazy<fgsig::combined<int(int), fgsig::sum<int>>>([]{return 1;}) == 0;
+
+    auto connection = std::optional<fgsig::owning_connection<signal, std::function<void(const std::string&)>, fgsig::signature_list<void(const std::string&)>>>{};
+    connection.emplace
+    (
+        sig,
+        [&](const std::string& value)
+        {
+            str += value;
+        }
+    );
+
+    //slot connected to another signature only
+    sig.emit_lazy<void(int, const std::string&)>
+    (
+        [&]
+        {
+            ++factory_call_count;
+            return std::make_tuple(0, std::string{"a"});
+        }
+    );
+    ok = ok && factory_call_count == 0;
+
+    sig.emit_lazy<void(const std::string&)>(factory);
+    ok = ok && factory_call_count == 1;
+    ok = ok && str == "event";
+    str.clear();
+
+    //blocked slot
+    connection->block();
+    sig.emit_lazy<void(const std::string&)>(factory);
+    ok = ok && factory_call_count == 1;
+    connection->unblock();
+
+    //slot closed during emission, whose closure is still in the list
+    {
+        auto closer = fgsig::connect
+        (
+            sig,
+            [&](int, const std::string&)
+            {
+                connection.reset();
+                sig.emit_lazy<void(const std::string&)>(factory);
+            },
+            fgsig::invocable_signatures
+        );
+        auto emitter = fgsig::connect
+        (
+            sig,
+            [&](const std::string& value)
+            {
+                if(value == "close")
+                    sig.emit(0, value);
+            },
+            fgsig::invocable_signatures
+        );
+        sig.emit(std::string{"close"});
+        ok = ok && str == "close";
+        ok = ok && factory_call_count == 2; //the emitter is still live
+        str.clear();
+    }
+
+    //only slot closed during emission
+    {
+        using slot_t = std::function<void(const std::string&)>;
+        auto self_connection = std::optional<fgsig::connection<signal, slot_t, fgsig::signature_list<void(const std::string&)>>>{};
+        auto self_closing_slot = slot_t
+        {
+            [&](const std::string&)
+            {
+                self_connection.reset();
+                sig.emit_lazy<void(const std::string&)>(factory);
+            }
+        };
+        self_connection.emplace(sig, self_closing_slot);
+        sig.emit(std::string{});
+        ok = ok && factory_call_count == 2;
+    }
+    sig.emit_lazy<void(const std::string&)>(factory);
+    ok = ok && factory_call_count == 2;
+
+    //several arguments
+    {
+        auto c = fgsig::connect
+        (
+            sig,
+            [&](const int i, const std::string& value)
+            {
+                str += std::to_string(i) + value;
+            },
+            fgsig::invocable_signatures
+        );
+        sig.emit_lazy<void(int, const std::string&)>([]{return std::make_tuple(1, std::string{"b"});});
+        ok = ok && str == "1b";
+        str.clear();
+    }
+
+    //combined signature
+    {
+        auto c0 = fgsig::connect(sig, [](const int i){return i;}, fgsig::invocable_signatures);
+        auto c1 = fgsig::connect(sig, [](const int i){return i * 10;}, fgsig::invocable_signatures);
+        ok = ok && sig.emit_lazy<fgsig::combined<int(int), fgsig::sum<int>>>([]{return 2;}) == 22;
+    }
+
+    //signatures without parameter: the factory is only called for its side
+    //effects
+    {
+        auto sig2 = fgsig::signal<void(), fgsig::combined<int(), fgsig::sum<int>>>{};
+
+        using combined_signature = fgsig::combined<int(), fgsig::sum<int>>;
+
+        auto call_count = 0;
+        auto c0 = fgsig::connect(sig2, [&]{++call_count;}, fgsig::signature_list<void()>{});
+        auto c1 = fgsig::connect(sig2, [&]{++call_count;}, fgsig::signature_list<void()>{});
+        auto c2 = fgsig::connect(sig2, []{return 3;}, fgsig::signature_list<combined_signature>{});
+
+        sig2.emit_lazy<void()>([&]{++factory_call_count;});
+        ok = ok && factory_call_count == 3;
+        ok = ok && call_count == 2;
+
+        ok = ok && sig2.emit_lazy<combined_signature>([&]{++factory_call_count;}) == 3;
+        ok = ok && factory_call_count == 4;
+
+        //all blocked
+        c0.block();
+        c1.block();
+        sig2.emit_lazy<void()>([&]{++factory_call_count;});
+        ok = ok && factory_call_count == 4;
+        c1.unblock();
+        sig2.emit_lazy<void()>([&]{++factory_call_count;});
+        ok = ok && factory_call_count == 5;
+    }
+
+    return ok;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef TESTS_EVENT_BUS_HPP
+#define TESTS_EVENT_BUS_HPP
+
+#include <fgsig.hpp>
+#include <sstream>
+
+namespace tests::event_bus
+{
+
+struct speed_event
+{
+    int value;
+};
+
+struct fuel_event
+{
+    int value;
+};
+
+struct stall_event{};
+
+using bus = fgsig::event_bus<speed_event, fuel_event, stall_event>;
+
+struct speed_slot
+{
+    void operator()(const speed_event& event)
+    {
+        oss << "s" << event.value;
+    }
+
+    std::ostringstream& oss;
+};
+
+bool test()
+{
+    auto ok = true;
+    std::ostringstream oss;
+
+    bus b;
+
+    //no subscriber
+    b.publish(speed_event{0});
+
+    auto slot0 = speed_slot{oss};
+    auto connection0 = b.subscribe<speed_event>(slot0);
+    auto connection1 = b.subscribe<fuel_event>([&oss](const fuel_event& event){oss << "f" << event.value;});
+    ok = ok && b.subscriber_count<speed_event>() == 1;
+    ok = ok && b.subscriber_count<fuel_event>() == 1;
+    ok = ok && b.subscriber_count<stall_event>() == 0;
+
+    b.publish(speed_event{1});
+    b.publish<fuel_event>({2});
+    b.publish(stall_event{});
+
+    connection0.close();
+    b.publish(speed_event{3});
+    b.publish(fuel_event{4});
+
+    return ok && oss.str() == "s1f2f4";
+}
+
+} //namespace
+
+#endif
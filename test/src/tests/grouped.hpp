@@ -0,0 +1,221 @@
+#ifndef TESTS_GROUPED_HPP
+#define TESTS_GROUPED_HPP
+
+#include "../utility/allocation_counter.hpp"
+#include <fgsig.hpp>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace tests::grouped
+{
+
+using signal = fgsig::signal<fgsig::grouped<void(int)>, void(char)>;
+
+template<char Name>
+struct slot
+{
+    void operator()(const int value)
+    {
+        *pstr += Name;
+        *pstr += std::to_string(value);
+    }
+
+    void operator()(const char value)
+    {
+        *pstr += Name;
+        *pstr += value;
+    }
+
+    std::string* pstr;
+    int value;
+};
+
+//Slot whose type is different for each index, so that each index gets its
+//own group
+template<std::size_t Index>
+struct indexed_slot
+{
+    void operator()(int)
+    {
+        *pstr += static_cast<char>('A' + Index);
+    }
+
+    void operator()(char)
+    {
+    }
+
+    std::string* pstr;
+};
+
+/*
+Check the order of the slots when many groups are created and removed, and
+that connecting doesn't allocate memory once enough has been reserved for the
+groups.
+*/
+template<std::size_t... Indexes>
+bool test_many_groups(std::index_sequence<Indexes...>)
+{
+    using utility::allocation_counter;
+
+    auto ok = true;
+    auto str = std::string{};
+    signal sig;
+
+    auto slots = std::make_tuple(indexed_slot<Indexes>{&str}...);
+    using connections = std::tuple<std::optional<signal::connection<indexed_slot<Indexes>>>...>;
+    auto first_connections = connections{};
+    auto second_connections = connections{};
+
+    sig.reserve(2 * sizeof...(Indexes));
+    {
+        const auto counter = allocation_counter{};
+        (std::get<Indexes>(first_connections).emplace(sig, std::get<Indexes>(slots)), ...);
+        (std::get<Indexes>(second_connections).emplace(sig, std::get<Indexes>(slots)), ...);
+        ok = ok && counter.check(0, 0);
+    }
+
+    const auto letters = [](const bool even, const bool odd, const int count)
+    {
+        auto letters = std::string{};
+        for(auto i = std::size_t{0}; i < sizeof...(Indexes); ++i)
+            if(i % 2 == 0 ? even : odd)
+                letters.append(count, static_cast<char>('A' + i));
+        return letters;
+    };
+
+    sig.emit(0);
+    ok = ok && str == letters(true, true, 2);
+    str.clear();
+
+    //remove the even groups and the first slot of the odd ones
+    (std::get<Indexes>(first_connections).reset(), ...);
+    ((Indexes % 2 == 0 ? std::get<Indexes>(second_connections).reset() : void()), ...);
+    sig.emit(0);
+    ok = ok && str == letters(false, true, 1);
+    str.clear();
+
+    //The odd slots join their group, while the even ones make new groups at
+    //the end.
+    (std::get<Indexes>(first_connections).emplace(sig, std::get<Indexes>(slots)), ...);
+    sig.emit(0);
+    ok = ok && str == letters(false, true, 2) + letters(true, false, 1);
+    str.clear();
+
+    return ok;
+}
+
+bool test_basic()
+{
+    auto ok = true;
+    auto str = std::string{};
+    signal sig;
+
+    auto a0 = slot<'a'>{&str, 0};
+    auto b0 = slot<'b'>{&str, 0};
+    auto a1 = slot<'a'>{&str, 1};
+    auto b1 = slot<'b'>{&str, 1};
+    auto c0 = slot<'c'>{&str, 0};
+    auto a2 = slot<'a'>{&str, 2};
+
+    auto connection_a0 = std::optional<signal::connection<slot<'a'>>>{};
+    connection_a0.emplace(sig, a0);
+    auto connection_b0 = fgsig::connect(sig, b0);
+    auto connection_a1 = std::optional<signal::connection<slot<'a'>>>{};
+    connection_a1.emplace(sig, a1);
+    auto connection_b1 = fgsig::connect(sig, b1);
+    auto connection_c0 = fgsig::connect(sig, c0);
+    auto connection_a2 = std::optional<signal::connection<slot<'a'>>>{};
+    connection_a2.emplace(sig, a2);
+
+    //grouped signature: slots of the same type are called one after the other
+    sig.emit(0);
+    ok = ok && str == "a0a0a0b0b0c0";
+    str.clear();
+
+    //other signature: connection order
+    sig.emit('x');
+    ok = ok && str == "axbxaxbxcxax";
+    str.clear();
+
+    //remove the first, the last and the only closure of a group
+    connection_a0.reset();
+    connection_a2.reset();
+    connection_c0.close();
+    auto a3 = slot<'a'>{&str, 3};
+    auto c1 = slot<'c'>{&str, 1};
+    auto connection_c1 = fgsig::connect(sig, c1);
+    auto connection_a3 = fgsig::connect(sig, a3);
+    sig.emit(1);
+    ok = ok && str == "a1a1b1b1c1";
+    str.clear();
+
+    //close during emission, then connect
+    {
+        auto closer = fgsig::connect
+        (
+            sig,
+            [&](const auto&)
+            {
+                connection_a1.reset();
+            }
+        );
+        sig.emit(2);
+        ok = ok && str == "a2a2b2b2c2";
+        str.clear();
+    }
+    auto a4 = slot<'a'>{&str, 4};
+    auto connection_a4 = fgsig::connect(sig, a4);
+    sig.emit(3);
+    ok = ok && str == "a3a3b3b3c3";
+    str.clear();
+    ok = ok && sig.slot_count<fgsig::grouped<void(int)>>() == 5;
+
+    //A slot connected during an emission is called by this emission, after
+    //the others, then joins its group.
+    {
+        auto a5 = slot<'a'>{&str, 5};
+        auto connection_a5 = std::optional<signal::connection<slot<'a'>>>{};
+        auto connector = fgsig::connect
+        (
+            sig,
+            [&](const auto&)
+            {
+                if(!connection_a5)
+                    connection_a5.emplace(sig, a5);
+            }
+        );
+        sig.emit(5);
+        ok = ok && str == "a5a5b5b5c5a5";
+        str.clear();
+
+        sig.emit(6);
+        ok = ok && str == "a6a6a6b6b6c6";
+        str.clear();
+    }
+
+    //reserved nodes are inserted at the right place too
+    sig.disconnect_all();
+    sig.reserve(4);
+    auto connection_b2 = fgsig::connect(sig, b0);
+    auto connection_c2 = fgsig::connect(sig, c0);
+    auto connection_b3 = fgsig::connect(sig, b1);
+    sig.emit(4);
+    ok = ok && str == "b4b4c4";
+    str.clear();
+
+    return ok;
+}
+
+bool test()
+{
+    auto ok = true;
+    ok = ok && test_basic();
+    ok = ok && test_many_groups(std::make_index_sequence<20>{});
+    return ok;
+}
+
+} //namespace
+
+#endif
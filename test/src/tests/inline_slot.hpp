@@ -0,0 +1,106 @@
+#ifndef TESTS_INLINE_SLOT_HPP
+#define TESTS_INLINE_SLOT_HPP
+
+#include "../utility/allocation_counter.hpp"
+#include <fgsig.hpp>
+#include <optional>
+#include <string>
+
+namespace tests::inline_slot
+{
+
+using signal = fgsig::signal<fgsig::inline_slots<void(int)>>;
+
+//Small trivially copyable slot, which owning connections store in the closure
+//of the signal
+struct small_slot
+{
+    void operator()(const int value)
+    {
+        ++call_count;
+        *plast_value = value;
+        *plast_this = this;
+        *plast_call_count = call_count;
+    }
+
+    int* plast_value;
+    const void** plast_this;
+    int* plast_call_count;
+    int call_count;
+};
+
+static_assert(fgsig::detail::is_inline_slot<small_slot, fgsig::inline_slots<void(int)>>::value);
+static_assert(fgsig::detail::is_inline_slot<small_slot, fgsig::non_reentrant<fgsig::inline_slots<void(int)>>>::value);
+static_assert(!fgsig::detail::is_inline_slot<std::string, fgsig::inline_slots<void(int)>>::value);
+
+//Other signatures don't pay for the storage.
+static_assert(!fgsig::detail::is_inline_slot<small_slot, void(int)>::value);
+static_assert(sizeof(fgsig::detail::raw_closure<void(int)>) == 2 * sizeof(void*));
+
+bool test()
+{
+    auto ok = true;
+    signal sig;
+
+    auto last_value = 0;
+    const void* last_this = nullptr;
+    auto last_call_count = 0;
+
+    auto connection0 = std::optional<signal::owning_connection<small_slot>>{};
+    connection0.emplace(sig, small_slot{&last_value, &last_this, &last_call_count, 0});
+
+    sig.emit(1);
+    ok = ok && last_value == 1;
+    ok = ok && last_call_count == 1;
+    const auto slot_address = last_this;
+
+    //moving the connection doesn't move the slot
+    auto connection1 = std::optional<signal::owning_connection<small_slot>>{};
+    {
+        const auto counter = utility::allocation_counter{};
+        connection1.emplace(std::move(*connection0));
+        ok = ok && counter.check(0, 0);
+    }
+    connection0.reset();
+
+    sig.emit(2);
+    ok = ok && last_value == 2;
+    ok = ok && last_call_count == 2;
+    ok = ok && last_this == slot_address;
+
+    connection1->block();
+    sig.emit(3);
+    ok = ok && last_value == 2;
+    connection1->unblock();
+
+    //close during emission
+    {
+        auto closing_connection = fgsig::connect
+        (
+            sig,
+            [&connection1](int)
+            {
+                connection1.reset();
+            }
+        );
+        sig.emit(4);
+        ok = ok && last_value == 4;
+        sig.emit(5);
+        ok = ok && last_value == 4;
+    }
+    ok = ok && sig.empty();
+
+    //disconnect_all()
+    {
+        auto connection2 = fgsig::connect(sig, small_slot{&last_value, &last_this, &last_call_count, 0});
+        sig.disconnect_all();
+        sig.emit(6);
+        ok = ok && last_value == 4;
+    }
+
+    return ok;
+}
+
+} //namespace
+
+#endif
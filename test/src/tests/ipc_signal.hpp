@@ -0,0 +1,310 @@
+#ifndef TESTS_IPC_SIGNAL_HPP
+#define TESTS_IPC_SIGNAL_HPP
+
+//Check that an ipc_signal delivers events to a child process, and back.
+//The child process runs the test executable again (with child_process_arg as
+//first argument), so that it doesn't inherit the state of the threads that
+//other tests have started.
+
+#ifdef __linux__
+
+#include <fgsig/ipc_signal.hpp>
+#include <chrono>
+#include <csignal>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace tests::ipc_signal
+{
+
+struct position
+{
+    double x;
+    double y;
+};
+
+struct done_event{};
+
+struct ready_event{};
+
+//parent to child
+using request_signal = fgsig::basic_ipc_signal
+<
+    16,
+    void(int),
+    void(const position&),
+    void(done_event)
+>;
+
+//child to parent
+using reply_signal = fgsig::ipc_signal
+<
+    void(ready_event),
+    void(int, double) //result
+>;
+
+constexpr auto child_process_arg = "--ipc-signal-child";
+
+int run_child(const std::string& request_name, const std::string& reply_name)
+{
+    auto request_mem = fgsig::ipc_shared_object<request_signal>::open(request_name.c_str());
+    auto reply_mem = fgsig::ipc_shared_object<reply_signal>::open(reply_name.c_str());
+    auto& reply_sig = reply_mem.get();
+
+    auto int_sum = 0;
+    auto position_sum = 0.0;
+    auto done = false;
+
+    fgsig::signal<void(int), void(const position&), void(done_event)> local_sig;
+    auto connection = fgsig::connect
+    (
+        local_sig,
+        [&](const auto& event)
+        {
+            using event_t = std::decay_t<decltype(event)>;
+            if constexpr(std::is_same_v<event_t, int>)
+                int_sum += event;
+            else if constexpr(std::is_same_v<event_t, position>)
+                position_sum += event.x + event.y;
+            else
+                done = true;
+        }
+    );
+    auto subscriber = fgsig::ipc_subscriber{request_mem.get(), local_sig};
+
+    reply_sig.emit(ready_event{});
+
+    while(!done)
+    {
+        subscriber.wait_and_drain(std::chrono::seconds{5});
+    }
+
+    reply_sig.emit(int_sum + static_cast<int>(subscriber.lost_count()) * 1000, position_sum);
+
+    return 0;
+}
+
+struct child_process
+{
+    public:
+        child_process(const std::string& request_name, const std::string& reply_name):
+            pid_(fork())
+        {
+            if(pid_ == 0)
+            {
+                execl("/proc/self/exe", "fgsig_test", child_process_arg, request_name.c_str(), reply_name.c_str(), nullptr);
+                _exit(127);
+            }
+        }
+
+        child_process(const child_process&) = delete;
+
+        child_process& operator=(const child_process&) = delete;
+
+        //Kill the process if it's still running.
+        ~child_process()
+        {
+            if(!status_)
+            {
+                kill(pid_, SIGKILL);
+                wait();
+            }
+        }
+
+        bool has_exited()
+        {
+            auto status = 0;
+            if(!status_ && waitpid(pid_, &status, WNOHANG) == pid_)
+                status_ = status;
+            return status_.has_value();
+        }
+
+        int wait()
+        {
+            auto status = 0;
+            if(!status_ && waitpid(pid_, &status, 0) == pid_)
+                status_ = status;
+            return status_.value_or(-1);
+        }
+
+    private:
+        pid_t pid_;
+        std::optional<int> status_;
+};
+
+/*
+Drain until the given flag is set.
+Give up if the child process exits without setting the flag, or after a few
+seconds.
+*/
+template<typename Subscriber>
+bool wait_for(const bool& flag, Subscriber& subscriber, child_process& child)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while(!flag)
+    {
+        const auto child_exited = child.has_exited();
+
+        subscriber.wait_and_drain(std::chrono::milliseconds{100});
+
+        if(!flag && (child_exited || std::chrono::steady_clock::now() > deadline))
+            return false;
+    }
+    return true;
+}
+
+//Check that a subscriber that doesn't keep up loses the oldest events.
+bool test_overwrite()
+{
+    auto sig = std::make_unique<request_signal>();
+
+    auto sum = 0;
+    fgsig::signal<void(int), void(const position&), void(done_event)> local_sig;
+    auto connection = fgsig::connect
+    (
+        local_sig,
+        [&](const auto& event)
+        {
+            if constexpr(std::is_same_v<std::decay_t<decltype(event)>, int>)
+                sum += event;
+        }
+    );
+    auto subscriber = fgsig::ipc_subscriber{*sig, local_sig};
+
+    for(auto i = 1; i <= 20; ++i)
+        sig->emit(i);
+
+    const auto count = subscriber.drain();
+
+    return
+        count == 16 &&
+        subscriber.lost_count() == 4 &&
+        sum == 210 - 10
+    ;
+}
+
+//Check that open() rejects an object that is being created or that has been
+//created for another type, instead of crashing on access.
+bool test_open_mismatch()
+{
+    const auto name = "/fgsig_test_mismatch_" + std::to_string(getpid());
+
+    const auto open_error = [&]
+    {
+        try
+        {
+            fgsig::ipc_shared_object<reply_signal>::open(name.c_str());
+        }
+        catch(const std::system_error& e)
+        {
+            return e.code();
+        }
+        return std::error_code{};
+    };
+
+    auto ok = true;
+
+    //as left by a creator between shm_open() and ftruncate()
+    const auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fd == -1)
+        return false;
+    close(fd);
+    ok = ok && open_error() == std::errc::resource_unavailable_try_again;
+    fgsig::ipc_shared_object<reply_signal>::remove(name.c_str());
+
+    {
+        auto request_mem = fgsig::ipc_shared_object<request_signal>::create(name.c_str());
+        ok = ok && open_error() == std::errc::invalid_argument;
+    }
+    fgsig::ipc_shared_object<request_signal>::remove(name.c_str());
+
+    return ok;
+}
+
+bool test()
+{
+    if(!test_overwrite())
+        return false;
+
+    if(!test_open_mismatch())
+        return false;
+
+    const auto suffix = std::to_string(getpid());
+    const auto request_name = "/fgsig_test_request_" + suffix;
+    const auto reply_name = "/fgsig_test_reply_" + suffix;
+
+    auto request_mem = fgsig::ipc_shared_object<request_signal>::create(request_name.c_str());
+    auto reply_mem = fgsig::ipc_shared_object<reply_signal>::create(reply_name.c_str());
+    auto& request_sig = request_mem.get();
+
+    auto ready = false;
+    auto result_received = false;
+    auto int_sum = 0;
+    auto position_sum = 0.0;
+    fgsig::signal<void(ready_event), void(int, double)> local_sig;
+    auto connection = fgsig::connect
+    (
+        local_sig,
+        [&](const auto&... values)
+        {
+            if constexpr(sizeof...(values) == 1)
+            {
+                ready = true;
+            }
+            else
+            {
+                result_received = true;
+                const auto result = std::make_tuple(values...);
+                int_sum = std::get<0>(result);
+                position_sum = std::get<1>(result);
+            }
+        }
+    );
+    auto subscriber = fgsig::ipc_subscriber{reply_mem.get(), local_sig};
+
+    auto ok = true;
+    {
+        auto child = child_process{request_name, reply_name};
+
+        ok = ok && wait_for(ready, subscriber, child);
+
+        if(ok)
+        {
+            //Emit fewer events than the capacity of the ring buffer, so that
+            //none of them is lost.
+            for(auto i = 1; i <= 10; ++i)
+                request_sig.emit(i);
+            request_sig.emit(position{1.5, 2.0});
+            request_sig.emit(done_event{});
+        }
+
+        ok = ok && wait_for(result_received, subscriber, child);
+
+        if(ok)
+        {
+            const auto status = child.wait();
+            ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+    }
+
+    fgsig::ipc_shared_object<request_signal>::remove(request_name.c_str());
+    fgsig::ipc_shared_object<reply_signal>::remove(reply_name.c_str());
+
+    return
+        ok &&
+        int_sum == 55 &&
+        position_sum == 3.5
+    ;
+}
+
+} //namespace
+
+#endif
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef TESTS_METHOD_SLOT_HPP
+#define TESTS_METHOD_SLOT_HPP
+
+#include <fgsig.hpp>
+#include <sstream>
+#include <string>
+
+namespace tests::method_slot
+{
+
+using signal = fgsig::signal
+<
+    void(int),
+    void(const std::string&)
+>;
+
+struct receiver
+{
+    void on_int(const int value)
+    {
+        oss << "i" << value;
+    }
+
+    void on_event(const int value)
+    {
+        oss << "ei" << value;
+    }
+
+    void on_event(const std::string& value) const
+    {
+        oss << "es" << value;
+    }
+
+    template<typename T>
+    void on_any(const T& value)
+    {
+        oss << "a" << value;
+    }
+
+    std::ostringstream& oss;
+};
+
+bool test()
+{
+    std::ostringstream oss;
+    signal sig;
+    receiver r{oss};
+
+    {
+        //overloaded member function
+        auto connection0 = fgsig::connect
+        <
+            fgsig::overload<int>(&receiver::on_event),
+            fgsig::overload<const std::string&>(&receiver::on_event)
+        >(sig, r);
+
+        //first member function that can be called with the arguments of the
+        //signature
+        auto connection1 = fgsig::connect
+        <
+            &receiver::on_int,
+            &receiver::on_any<std::string>
+        >(sig, r);
+
+        auto connection1b = std::move(connection1);
+
+        sig.emit(1);
+        sig.emit("a");
+    }
+
+    sig.emit(2);
+
+    const auto expected_str =
+        "ei1i1"
+        "esaaa"
+    ;
+
+    return oss.str() == expected_str;
+}
+
+} //namespace
+
+#endif
@@ -69,10 +69,29 @@ bool test()
 
     sig.emit(99);
 
+    //moving connections keeps the call order
+    auto connection2c = std::move(connection2b);
+    auto connection1c = std::move(connection1b);
+    auto connection0c = std::move(connection0b);
+    sig.emit(98);
+
+    //moving closed connections
+    {
+        auto connection3 = fgsig::connect(sig, std::function<void(int)>{[](int){}});
+        auto connection4 = fgsig::connect(sig, slot0);
+        connection3.close();
+        connection4.close();
+        auto connection3b = std::move(connection3);
+        auto connection4b = std::move(connection4);
+    }
+
     const auto expected_str =
         "099"
         "199"
         "299"
+        "098"
+        "198"
+        "298"
     ;
     return oss.str() == expected_str;
 }
@@ -0,0 +1,88 @@
+#ifndef TESTS_NON_REENTRANT_HPP
+#define TESTS_NON_REENTRANT_HPP
+
+#include <fgsig.hpp>
+#include <sstream>
+#include <string>
+
+namespace tests::non_reentrant
+{
+
+using signal = fgsig::signal
+<
+    fgsig::non_reentrant<void(int)>,
+    fgsig::non_reentrant<fgsig::combined<int(int, int), fgsig::sum<int>>>,
+    void(const std::string&)
+>;
+
+struct slot
+{
+    void operator()(const int value)
+    {
+        oss << id << value;
+    }
+
+    int operator()(const int a, const int b)
+    {
+        return a * b * id;
+    }
+
+    void operator()(const std::string& value)
+    {
+        oss << id << value;
+    }
+
+    std::ostringstream& oss;
+    int id;
+};
+
+bool test()
+{
+    auto ok = true;
+    std::ostringstream oss;
+    signal sig;
+
+    ok = ok && sig.emit(2, 3) == 0;
+
+    auto slot1 = slot{oss, 1};
+    auto slot2 = slot{oss, 2};
+    auto connection1 = fgsig::connect(sig, slot1);
+
+    {
+        auto connection2 = fgsig::connect(sig, slot2);
+        ok = ok && sig.slot_count<fgsig::non_reentrant<void(int)>>() == 2;
+
+        sig.emit(0);
+        ok = ok && sig.emit(2, 3) == 18;
+
+        connection2.block();
+        sig.emit(1);
+        ok = ok && sig.emit(2, 3) == 6;
+        connection2.unblock();
+    }
+    ok = ok && sig.slot_count<fgsig::non_reentrant<void(int)>>() == 1;
+
+    //the reentrant signatures still support closing a connection during
+    //emission
+    {
+        auto closing_slot = [&connection1](const std::string&)
+        {
+            connection1.close();
+        };
+        auto connection3 = fgsig::connect(sig, closing_slot, fgsig::invocable_signatures);
+        sig.emit("a");
+        sig.emit("b");
+    }
+
+    sig.emit(2);
+    ok = ok && sig.emit(2, 3) == 0;
+    ok = ok && sig.empty();
+
+    ok = ok && oss.str() == "1020111a";
+
+    return ok;
+}
+
+} //namespace
+
+#endif
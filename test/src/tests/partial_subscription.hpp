@@ -0,0 +1,170 @@
+#ifndef TESTS_PARTIAL_SUBSCRIPTION_HPP
+#define TESTS_PARTIAL_SUBSCRIPTION_HPP
+
+//Check fgsig::invocable_signatures and fgsig::signature_list.
+
+#include "../utility/allocation_counter.hpp"
+#include <fgsig.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tests::partial_subscription
+{
+
+struct event
+{
+    int value;
+};
+
+using signal = fgsig::signal
+<
+    void(int),
+    void(const std::string&),
+    void(const event&)
+>;
+
+struct receiver
+{
+    void on_int(const int value)
+    {
+        oss << 'm' << value;
+    }
+
+    std::ostringstream& oss;
+};
+
+//on_int() can be called with a long, but doesn't return an int.
+struct counting_receiver
+{
+    void on_int(const int value)
+    {
+        oss << 'v' << value;
+    }
+
+    int count(const long value)
+    {
+        oss << 'c' << value;
+        return static_cast<int>(value);
+    }
+
+    std::ostringstream& oss;
+};
+
+struct tracking_receiver: fgsig::trackable
+{
+    void operator()(const event& e)
+    {
+        oss << 't' << e.value;
+    }
+
+    std::ostringstream& oss;
+};
+
+struct generic_slot
+{
+    template<typename T>
+    void operator()(const T&)
+    {
+    }
+};
+
+struct string_slot
+{
+    void operator()(const std::string& value)
+    {
+        oss << 's' << value;
+    }
+
+    std::ostringstream& oss;
+};
+
+bool test()
+{
+    auto ok = true;
+    std::ostringstream oss;
+    signal sig;
+    sig.reserve(1);
+
+    //slot callable with one signature only
+    {
+        const auto counter = utility::allocation_counter{};
+        auto slot = [&oss](const std::string& value){oss << 'l' << value;};
+        auto c = fgsig::connect(sig, slot, fgsig::invocable_signatures);
+
+        //one event closure and one destruction closure, within the reserved
+        //capacity
+        ok = ok && counter.check(0, 0);
+        ok = ok && sig.slot_count<void(int)>() == 0;
+        ok = ok && sig.slot_count<void(const std::string&)>() == 1;
+        ok = ok && sig.slot_count<void(const event&)>() == 0;
+
+        ok = ok && sizeof(c) < sizeof(signal::connection<generic_slot>);
+
+        sig.emit(0);
+        sig.emit("a");
+        sig.emit(event{0});
+    }
+
+    //explicit signature list
+    {
+        auto slot = [&oss](const auto&){oss << 'g';};
+        auto c0 = fgsig::connect(sig, slot, fgsig::signature_list<void(int)>{});
+        auto c1 = fgsig::connect(sig, [&oss](const auto&){oss << 'o';}, fgsig::signature_list<void(int), void(const event&)>{});
+        ok = ok && sig.slot_count<void(int)>() == 2;
+        ok = ok && sig.slot_count<void(const std::string&)>() == 0;
+        ok = ok && sig.slot_count<void(const event&)>() == 1;
+
+        sig.emit(1);
+        sig.emit("b");
+        sig.emit(event{1});
+    }
+    ok = ok && sig.empty();
+
+    //member function
+    {
+        auto r = receiver{oss};
+        auto c = fgsig::connect<&receiver::on_int>(sig, r, fgsig::invocable_signatures);
+        ok = ok && sig.slot_count<void(int)>() == 1;
+        ok = ok && sig.slot_count<void(const std::string&)>() == 0;
+        sig.emit(2);
+    }
+
+    //trackable
+    {
+        auto r = tracking_receiver{{}, oss};
+        fgsig::connect(sig, r, fgsig::invocable_signatures);
+        ok = ok && sig.slot_count<void(const event&)>() == 1;
+        ok = ok && sig.slot_count<void(int)>() == 0;
+        sig.emit(event{3});
+    }
+
+    //range of slots
+    {
+        auto slots = std::vector<string_slot>{string_slot{oss}, string_slot{oss}};
+        auto c = fgsig::connect_many(sig, slots, fgsig::invocable_signatures);
+        ok = ok && sig.slot_count<void(const std::string&)>() == 2;
+        ok = ok && sig.slot_count<void(int)>() == 0;
+        sig.emit("c");
+    }
+
+    ok = ok && sig.empty();
+
+    //member functions of combined signatures must return a compatible type
+    {
+        using counting_signal = fgsig::signal<void(int), fgsig::combined<int(long), fgsig::sum<int>>>;
+        counting_signal csig;
+        auto r = counting_receiver{oss};
+        auto c = fgsig::connect<&counting_receiver::on_int, &counting_receiver::count>(csig, r);
+        csig.emit(4);
+        ok = ok && csig.emit(5L) == 5;
+    }
+
+    ok = ok && oss.str() == "lagoom2t3scscv4c5";
+
+    return ok;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef TESTS_SIGNAL_ARRAY_HPP
+#define TESTS_SIGNAL_ARRAY_HPP
+
+#include <fgsig.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tests::signal_array
+{
+
+using signal_array = fgsig::signal_array<void(int), void(const std::string&)>;
+
+struct receiver
+{
+    void operator()(const int value)
+    {
+        *pstr += name + std::to_string(value);
+    }
+
+    std::string* pstr;
+    std::string name;
+};
+
+bool test()
+{
+    auto ok = true;
+    auto str = std::string{};
+
+    auto sigs = std::optional<signal_array>{};
+    sigs.emplace(3);
+    ok = ok && sigs->size() == 3;
+
+    auto receiver_a = receiver{&str, "a"};
+    auto connection_a = sigs->connect(0, receiver_a, fgsig::invocable_signatures);
+    auto connection_b = sigs->connect(2, receiver{&str, "b"}, fgsig::invocable_signatures);
+    auto connection_c = sigs->connect(0, receiver{&str, "c"}, fgsig::invocable_signatures);
+    auto connection_s = sigs->connect
+    (
+        1,
+        [&str](const std::string& value)
+        {
+            str += value;
+        },
+        fgsig::invocable_signatures
+    );
+    ok = ok && sigs->slot_count<void(int)>() == 3;
+    ok = ok && sigs->slot_count<void(const std::string&)>() == 1;
+
+    //per-entity emission, in connection order
+    sigs->emit(0, 1);
+    sigs->emit(1, 2);
+    sigs->emit(2, 3);
+    sigs->emit(1, std::string{"s"});
+    sigs->emit(2, std::string{"t"});
+    ok = ok && str == "a1c1b3s";
+    str.clear();
+
+    //emission to all entities
+    sigs->emit_all(4);
+    ok = ok && str == "a4b4c4";
+    str.clear();
+
+    //moving an owning connection
+    {
+        auto moved_connection_b = std::move(connection_b);
+        sigs->emit(2, 5);
+        ok = ok && str == "b5";
+        str.clear();
+    }
+    sigs->emit_all(6);
+    ok = ok && str == "a6c6";
+    str.clear();
+
+    //closing during emission, and reusing the row of a closed connection
+    {
+        auto connection_d = std::optional<decltype(sigs->connect(1, receiver{}, fgsig::invocable_signatures))>{};
+        auto closer = sigs->connect
+        (
+            1,
+            [&](const int)
+            {
+                connection_a.close();
+                connection_d.emplace(sigs->connect(1, receiver{&str, "d"}, fgsig::invocable_signatures));
+            },
+            fgsig::invocable_signatures
+        );
+        sigs->emit_all(7);
+        ok = ok && str == "a7c7d7";
+        str.clear();
+
+        closer.close();
+        sigs->emit_all(8);
+        ok = ok && str == "c8d8";
+        str.clear();
+    }
+    ok = ok && sigs->slot_count<void(int)>() == 1;
+
+    //the signal array is destroyed before the connections
+    sigs.reset();
+    connection_c.close();
+
+    //an entity without slots only costs an index per signature
+    {
+        auto many_sigs = signal_array{100000};
+        auto connections = std::vector<decltype(many_sigs.connect(0, receiver{}, fgsig::invocable_signatures))>{};
+        connections.reserve(10);
+        for(auto i = 0; i < 10; ++i)
+            connections.push_back(many_sigs.connect(i * 1000, receiver{&str, ""}, fgsig::invocable_signatures));
+
+        ok = ok && many_sigs.memory_usage() < 100000 * 2 * sizeof(std::uint32_t) + 4096;
+
+        many_sigs.emit_all(9);
+        ok = ok && str == "9999999999";
+        str.clear();
+    }
+
+    return ok;
+}
+
+} //namespace
+
+#endif
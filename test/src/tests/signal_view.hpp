@@ -0,0 +1,68 @@
+#ifndef TESTS_SIGNAL_VIEW_HPP
+#define TESTS_SIGNAL_VIEW_HPP
+
+#include <fgsig.hpp>
+#include <sstream>
+#include <string>
+
+namespace tests::signal_view
+{
+
+using signal = fgsig::signal<void(int), void(const std::string&)>;
+
+bool test()
+{
+    auto ok = true;
+    std::ostringstream oss;
+    signal sig;
+
+    const auto even = fgsig::filter(sig, [](const int value){return value % 2 == 0;});
+    const auto squared_even = fgsig::transform(even, [](const int value){return value * value;});
+    const auto lengths = fgsig::transform(sig, [](const std::string& value){return value.size();});
+
+    //no subscriber, no upstream connection
+    ok = ok && sig.empty();
+
+    {
+        auto slot = [&oss](const int value){oss << 'e' << value;};
+        auto c0 = fgsig::connect(even, slot);
+        auto c1 = fgsig::connect(squared_even, [&oss](const int value){oss << 's' << value;});
+        auto c2 = fgsig::connect(lengths, [&oss](const std::size_t value){oss << 'l' << value;});
+
+        //views only connect to the signatures their slot can be called with
+        ok = ok && sig.slot_count<void(int)>() == 2;
+        ok = ok && sig.slot_count<void(const std::string&)>() == 1;
+
+        sig.emit(1);
+        sig.emit(2);
+        sig.emit("abc");
+    }
+
+    //subscribers gone, upstream connections gone
+    ok = ok && sig.empty();
+
+    sig.emit(4);
+
+    //views of temporary views
+    {
+        auto c = fgsig::connect
+        (
+            fgsig::transform
+            (
+                fgsig::filter(sig, [](const int value){return value != 5;}),
+                [](const int value){return value + 1;}
+            ),
+            [&oss](const int value){oss << 't' << value;}
+        );
+        sig.emit(5);
+        sig.emit(6);
+    }
+
+    ok = ok && oss.str() == "e2s4l3t7";
+
+    return ok;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef TESTS_TRACING_HPP
+#define TESTS_TRACING_HPP
+
+#include <fgsig.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace tests::tracing
+{
+
+using signal = fgsig::signal<void(int)>;
+
+struct recursive_slot
+{
+    void operator()(const int value)
+    {
+        if(value > 0)
+            psig->emit(value - 1);
+    }
+
+    signal* psig;
+};
+
+inline std::size_t count(const std::string& str, const std::string& substr)
+{
+    auto n = std::size_t{0};
+    for(auto pos = str.find(substr); pos != std::string::npos; pos = str.find(substr, pos + 1))
+        ++n;
+    return n;
+}
+
+//Stop the tracing at the first call, start it again at the second one.
+struct toggling_slot
+{
+    void operator()(int)
+    {
+        if(call_count++ == 0)
+            fgsig::stop_tracing();
+        else
+            fgsig::start_tracing();
+    }
+
+    int call_count = 0;
+};
+
+inline std::string timestamp_to_string(const std::int64_t timestamp)
+{
+    auto out = std::ostringstream{};
+    fgsig::detail::write_trace_timestamp(out, timestamp);
+    return out.str();
+}
+
+bool test_timestamp_format()
+{
+    return
+        timestamp_to_string(0) == "0.000" &&
+        timestamp_to_string(1'234'005) == "1234.005" &&
+        timestamp_to_string(-1'500) == "-1.500" &&
+        timestamp_to_string(-7) == "-0.007"
+    ;
+}
+
+//Toggling the tracing during an emission mustn't produce unmatched events.
+bool test_toggle_during_emission()
+{
+    auto ok = true;
+
+    signal sig;
+    auto slot = toggling_slot{};
+    auto connection = fgsig::connect(sig, slot);
+    auto out = std::ostringstream{};
+
+    //stopped while the slot runs: the end events are still recorded
+    fgsig::start_tracing();
+    sig.emit(0);
+    fgsig::write_chrome_trace(out);
+    const auto stopped_trace = out.str();
+
+    //started while the slot runs: the end events aren't recorded
+    sig.emit(0);
+    fgsig::stop_tracing();
+    out.str("");
+    fgsig::write_chrome_trace(out);
+    const auto started_trace = out.str();
+
+#ifdef FGSIG_ENABLE_TRACING
+    ok = ok && count(stopped_trace, "\"ph\":\"B\"") == 2;
+    ok = ok && count(stopped_trace, "\"ph\":\"E\"") == 2;
+    ok = ok && count(started_trace, "\"ph\"") == 0;
+#else
+    ok = ok && count(stopped_trace, "\"ph\"") == 0;
+    ok = ok && count(started_trace, "\"ph\"") == 0;
+#endif
+
+    return ok;
+}
+
+bool test_nested_emissions()
+{
+    auto ok = true;
+
+    signal sig;
+    auto slot = recursive_slot{&sig};
+    auto connection = fgsig::connect(sig, slot);
+
+    fgsig::start_tracing();
+    sig.emit(1);
+    fgsig::stop_tracing();
+
+    //not recorded
+    sig.emit(0);
+
+    auto out = std::ostringstream{};
+    fgsig::write_chrome_trace(out);
+    const auto trace = out.str();
+
+    ok = ok && trace.find("{\"traceEvents\":[") == 0;
+    ok = ok && trace.find("\"dropped_events\":0") != std::string::npos;
+
+#ifdef FGSIG_ENABLE_TRACING
+    //two nested emissions, each calling the slot once
+    ok = ok && count(trace, "\"cat\":\"emit\",\"ph\":\"B\"") == 2;
+    ok = ok && count(trace, "\"cat\":\"emit\",\"ph\":\"E\"") == 2;
+    ok = ok && count(trace, "\"cat\":\"slot\",\"ph\":\"B\"") == 2;
+    ok = ok && count(trace, "\"cat\":\"slot\",\"ph\":\"E\"") == 2;
+    ok = ok && count(trace, "\"name\":\"void(int)\"") == 4;
+    ok = ok && count(trace, "recursive_slot") == 4;
+    ok = ok && count(trace, "\"depth\":2") == 4;
+
+    //events that don't fit in the buffer are dropped
+    fgsig::start_tracing(2);
+    sig.emit(0);
+    fgsig::stop_tracing();
+    out.str("");
+    fgsig::write_chrome_trace(out);
+    ok = ok && out.str().find("\"dropped_events\":2") != std::string::npos;
+#else
+    //tracing is compiled out
+    ok = ok && count(trace, "\"ph\"") == 0;
+#endif
+
+    return ok;
+}
+
+bool test()
+{
+    auto ok = true;
+    ok = ok && test_timestamp_format();
+    ok = ok && test_toggle_during_emission();
+    ok = ok && test_nested_emissions();
+    return ok;
+}
+
+} //namespace
+
+#endif
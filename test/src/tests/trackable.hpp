@@ -0,0 +1,165 @@
+#ifndef TESTS_TRACKABLE_HPP
+#define TESTS_TRACKABLE_HPP
+
+#include "../utility/allocation_counter.hpp"
+#include <fgsig.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace tests::trackable
+{
+
+using signal = fgsig::signal<void(int), void(const std::string&)>;
+
+struct receiver: fgsig::trackable
+{
+    receiver(std::ostringstream& oss, const int id):
+        oss(oss),
+        id(id)
+    {
+    }
+
+    void operator()(const int value)
+    {
+        oss << id << value;
+    }
+
+    void operator()(const std::string& value)
+    {
+        oss << id << value;
+    }
+
+    void on_int(const int value)
+    {
+        oss << id << '#' << value;
+    }
+
+    void on_string(const std::string& value)
+    {
+        oss << id << '#' << value;
+    }
+
+    std::ostringstream& oss;
+    int id;
+};
+
+struct self_destroying_receiver: fgsig::trackable
+{
+    void operator()(int)
+    {
+        pself.reset();
+    }
+
+    void operator()(const std::string&)
+    {
+    }
+
+    std::unique_ptr<self_destroying_receiver>& pself;
+};
+
+bool test()
+{
+    auto ok = true;
+    std::ostringstream oss;
+
+    //trackable destroyed before signals
+    {
+        signal sig0;
+        signal sig1;
+
+        {
+            auto receiver0 = receiver{oss, 0};
+            fgsig::connect(sig0, receiver0);
+            fgsig::connect(sig1, receiver0);
+            fgsig::connect<&receiver::on_int, &receiver::on_string>(sig0, receiver0);
+            ok = ok && receiver0.subscription_count() == 3;
+
+            sig0.emit(1);
+            sig1.emit("a");
+
+            //copies don't inherit connections
+            const auto receiver0_copy = receiver0;
+            ok = ok && receiver0_copy.subscription_count() == 0;
+        }
+
+        ok = ok && sig0.empty();
+        ok = ok && sig1.empty();
+        sig0.emit(2);
+    }
+
+    //signal destroyed before trackable
+    {
+        auto receiver1 = receiver{oss, 1};
+        signal sig0;
+
+        {
+            signal sig1;
+            fgsig::connect(sig0, receiver1);
+            fgsig::connect(sig1, receiver1);
+            ok = ok && receiver1.subscription_count() == 2;
+        }
+
+        ok = ok && receiver1.subscription_count() == 1;
+        sig0.emit(3);
+
+        receiver1.close_subscriptions();
+        ok = ok && receiver1.subscription_count() == 0;
+        ok = ok && sig0.empty();
+        sig0.emit(4);
+    }
+
+    //trackable destroyed during emission
+    {
+        signal sig;
+        auto receiver2 = receiver{oss, 2};
+        auto preceiver3 = std::unique_ptr<self_destroying_receiver>{};
+        preceiver3 = std::make_unique<self_destroying_receiver>(self_destroying_receiver{{}, preceiver3});
+        fgsig::connect(sig, *preceiver3);
+        fgsig::connect(sig, receiver2);
+
+        sig.emit(5);
+        ok = ok && !preceiver3;
+        ok = ok && sig.slot_count<void(int)>() == 1;
+        sig.emit(6);
+    }
+
+    ok = ok && oss.str() == "010#10a132526";
+
+    //memory of the subscriptions
+    {
+        constexpr auto subscription_count = 1000;
+
+        signal sig;
+        sig.reserve(subscription_count);
+        auto receiver4 = receiver{oss, 4};
+
+        {
+            const auto counter = utility::allocation_counter{};
+            for(auto i = 0; i < subscription_count; ++i)
+                fgsig::connect(sig, receiver4);
+            ok = ok && counter.allocation_count() < subscription_count / 20;
+        }
+
+        //A subscription used to be a heap block of its own, as large as a
+        //connection plus two pointers, plus the header of the allocator.
+        const auto subscription_memory_usage = receiver4.memory_usage() - sizeof(fgsig::trackable);
+        ok = ok && subscription_memory_usage < subscription_count * (sizeof(signal::connection<receiver>) + 4 * sizeof(void*));
+
+        //closing then connecting again reuses the memory
+        receiver4.close_subscriptions();
+        {
+            const auto counter = utility::allocation_counter{};
+            for(auto i = 0; i < subscription_count; ++i)
+                fgsig::connect(sig, receiver4);
+            ok = ok && counter.check(0, 0);
+        }
+        ok = ok && receiver4.subscription_count() == subscription_count;
+    }
+
+    return ok;
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef UTILITY_ALLOCATION_COUNTER_HPP
+#define UTILITY_ALLOCATION_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace utility
+{
+
+//Incremented by the replacements of the global operator new and delete (see
+//allocation_hooks.cpp).
+extern std::atomic<std::size_t> global_allocation_count;
+extern std::atomic<std::size_t> global_deallocation_count;
+
+/*
+allocation_counter counts the calls to the global operator new and delete
+since its construction.
+*/
+struct allocation_counter
+{
+    public:
+        allocation_counter():
+            initial_allocation_count_(global_allocation_count),
+            initial_deallocation_count_(global_deallocation_count)
+        {
+        }
+
+        std::size_t allocation_count() const
+        {
+            return global_allocation_count - initial_allocation_count_;
+        }
+
+        std::size_t deallocation_count() const
+        {
+            return global_deallocation_count - initial_deallocation_count_;
+        }
+
+        bool check(const std::size_t expected_allocation_count, const std::size_t expected_deallocation_count) const
+        {
+            return
+                allocation_count() == expected_allocation_count &&
+                deallocation_count() == expected_deallocation_count
+            ;
+        }
+
+    private:
+        std::size_t initial_allocation_count_;
+        std::size_t initial_deallocation_count_;
+};
+
+} //namespace
+
+#endif